@@ -0,0 +1,108 @@
+#include <cu0/proc/cgroup.hh>
+#include <cu0/proc/process.hh>
+#include <cassert>
+#include <fstream>
+#include <string>
+
+int main(int argc, char** argv) {
+  //! for subprocess check
+  if (argc > 1) {
+    //! returns 0 if the process is in the specified cgroup
+    auto cgroups = std::ifstream{"/proc/self/cgroup"};
+    for (auto line = std::string{}; std::getline(cgroups, line);) {
+      if (line.starts_with("0::/")) {
+        return line.ends_with("/" + std::string{argv[1]}) ? 0 : 1;
+      }
+    }
+    return 2;
+  }
+
+#if \
+    __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>) && \
+    __has_include(<unistd.h>) && \
+    __has_include(<sys/wait.h>)
+  const auto current = cu0::Cgroup::current();
+  if (!current.has_value()) {
+    //! no cgroup v2 hierarchy => nothing to check
+    return 0;
+  }
+  assert(std::filesystem::is_directory(current.value()));
+  const auto name = "cu0_check_" + std::to_string(::getpid());
+  const auto path = current.value() / name;
+  {
+    auto created = cu0::Cgroup::create(path);
+    if (std::holds_alternative<cu0::Cgroup::CreateError>(created)) {
+      //! the hierarchy is not writable => nothing to check
+      return 0;
+    }
+    auto& cgroup = std::get<cu0::Cgroup>(created);
+    assert(cgroup.fd() >= 0);
+    assert(cgroup.path() == path);
+    assert(std::filesystem::is_directory(path));
+    const auto existing = cu0::Cgroup::create(path);
+    assert(std::holds_alternative<cu0::Cgroup::CreateError>(existing));
+    assert(
+        std::get<cu0::Cgroup::CreateError>(existing) ==
+            cu0::Cgroup::CreateError::EXIST
+    );
+
+    //! controllers may be not enabled in the parent cgroup
+    const auto memory = cgroup.memory_max(std::uint64_t{1} << 30);
+    assert(
+        std::holds_alternative<std::monostate>(memory) ||
+        std::get<cu0::Cgroup::WriteError>(memory) ==
+            cu0::Cgroup::WriteError::NOENT
+    );
+    if (std::holds_alternative<std::monostate>(memory)) {
+      auto memory_max = std::ifstream{path / "memory.max"};
+      auto value = std::string{};
+      memory_max >> value;
+      assert(value == std::to_string(std::uint64_t{1} << 30));
+    }
+    const auto cpu = cgroup.cpu_max(std::chrono::milliseconds{50});
+    assert(
+        std::holds_alternative<std::monostate>(cpu) ||
+        std::get<cu0::Cgroup::WriteError>(cpu) ==
+            cu0::Cgroup::WriteError::NOENT
+    );
+
+    auto moved = cu0::Cgroup{std::move(cgroup)};
+    assert(moved.path() == path);
+    auto options = cu0::SpawnOptions{};
+    options.cgroup = moved.fd();
+    auto process_variant = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { name, },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process>(process_variant));
+    auto& process = std::get<cu0::Process>(process_variant);
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 0);
+
+    //! invalid cgroup => the process is not created
+    options.cgroup = -1;
+    const auto not_created = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { name, },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process::CreateError>(not_created));
+  }
+  //! the cgroup is removed when it is destructed
+  assert(!std::filesystem::exists(path));
+#else
+  (void)argc;
+  (void)argv;
+#warning <fcntl.h> or <sys/stat.h> or <unistd.h> or <sys/wait.h> is not \
+found => cu0::Cgroup will not be checked
+#endif
+
+  return 0;
+}
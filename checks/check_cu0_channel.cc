@@ -0,0 +1,224 @@
+#include <cu0/proc/channel.hh>
+#include <cu0/proc/process.hh>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+//! the other side of a channel which corrupts the shared control data
+struct Peer : cu0::Channel {
+  using cu0::Channel::Header;
+  //! maps the control data of a channel
+  static Header& header_of(const cu0::Channel& channel) {
+    auto* memory = ::mmap(
+        NULL,
+        sizeof(Header),
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        channel.fd(),
+        0
+    );
+    assert(memory != MAP_FAILED);
+    return *static_cast<Header*>(memory);
+  }
+};
+#endif
+
+int main(int argc, char** argv) {
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+  //! for subprocess check
+  if (argc > 2 && std::string{argv[1]} == "echo") {
+    auto attached = cu0::Channel::attach(std::stoi(argv[2]));
+    if (!std::holds_alternative<cu0::Channel>(attached)) {
+      return 1;
+    }
+    const auto& channel = std::get<cu0::Channel>(attached);
+    char buffer[100];
+    //! echo everything back until the parent closes the channel
+    for (
+        auto bytes = channel.read(buffer, sizeof(buffer));
+        bytes != 0;
+        bytes = channel.read(buffer, sizeof(buffer))
+    ) {
+      if (channel.write(buffer, bytes) != bytes) {
+        return 2;
+      }
+    }
+    return 0;
+  }
+
+  {
+    const auto invalid = cu0::Channel::create(0);
+    assert(std::holds_alternative<cu0::Channel::CreateError>(invalid));
+    assert(
+        std::get<cu0::Channel::CreateError>(invalid) ==
+            cu0::Channel::CreateError::INVAL
+    );
+    const auto not_attached = cu0::Channel::attach(-1);
+    assert(std::holds_alternative<cu0::Channel::AttachError>(not_attached));
+    assert(
+        std::get<cu0::Channel::AttachError>(not_attached) ==
+            cu0::Channel::AttachError::BADF
+    );
+  }
+
+  {
+    //! both sides in this process
+    auto created = cu0::Channel::create(1000);
+    assert(std::holds_alternative<cu0::Channel>(created));
+    const auto& parent = std::get<cu0::Channel>(created);
+    assert(parent.fd() >= 0);
+    assert(parent.capacity() == 1024);
+    auto attached = cu0::Channel::attach(::dup(parent.fd()));
+    assert(std::holds_alternative<cu0::Channel>(attached));
+    const auto& child = std::get<cu0::Channel>(attached);
+    assert(child.capacity() == 1024);
+
+    assert(parent.write("abc", 3) == 3);
+    char buffer[8] = {};
+    assert(child.read(buffer, sizeof(buffer)) == 3);
+    assert(std::string(buffer, 3) == "abc");
+    assert(child.write("defg", 4) == 4);
+    assert(parent.read(buffer, 2) == 2);
+    assert(std::string(buffer, 2) == "de");
+    assert(parent.read(buffer, sizeof(buffer)) == 2);
+    assert(std::string(buffer, 2) == "fg");
+
+    //! more data than the capacity => the writer waits for the reader
+    auto data = std::string{};
+    for (auto i = 0; i < 100000; i++) {
+      data += static_cast<char>('a' + i % 26);
+    }
+    auto writer = std::thread([&parent, &data](){
+      assert(parent.write(data.data(), data.size()) == data.size());
+      parent.close();
+    });
+    auto received = std::string{};
+    char chunk[333];
+    for (
+        auto bytes = child.read(chunk, sizeof(chunk));
+        bytes != 0;
+        bytes = child.read(chunk, sizeof(chunk))
+    ) {
+      received.append(chunk, bytes);
+    }
+    writer.join();
+    assert(received == data);
+    //! closed => writes do not block
+    assert(child.write("x", 1) == 0);
+  }
+
+  {
+    //! the capacity is not reread after the other side modifies it
+    auto created = cu0::Channel::create(1024);
+    assert(std::holds_alternative<cu0::Channel>(created));
+    const auto& parent = std::get<cu0::Channel>(created);
+    auto& header = Peer::header_of(parent);
+    header.capacity = std::uint64_t{1} << 40;
+    assert(parent.capacity() == 1024);
+    assert(parent.write("abc", 3) == 3);
+    ::munmap(&header, sizeof(header));
+  }
+
+  {
+    //! the head of the other side is far ahead of the tail =>
+    //!     a short read instead of a read past the ring
+    auto created = cu0::Channel::create(1024);
+    assert(std::holds_alternative<cu0::Channel>(created));
+    const auto& parent = std::get<cu0::Channel>(created);
+    auto attached = cu0::Channel::attach(::dup(parent.fd()));
+    assert(std::holds_alternative<cu0::Channel>(attached));
+    const auto& child = std::get<cu0::Channel>(attached);
+    assert(parent.write("abc", 3) == 3);
+    auto& header = Peer::header_of(parent);
+    header.down.head.store(std::uint64_t{1} << 20);
+    auto buffer = std::vector<char>(1 << 20);
+    assert(child.read(buffer.data(), buffer.size()) == 0);
+    //! the broken channel is closed => writes do not block
+    assert(child.write("x", 1) == 0);
+    ::munmap(&header, sizeof(header));
+  }
+
+  {
+    //! the tail of the other side is ahead of the head =>
+    //!     a short write instead of a write past the ring
+    auto created = cu0::Channel::create(1024);
+    assert(std::holds_alternative<cu0::Channel>(created));
+    const auto& parent = std::get<cu0::Channel>(created);
+    auto& header = Peer::header_of(parent);
+    header.down.tail.store(100);
+    const auto data = std::string(4096, 'x');
+    assert(parent.write(data.data(), data.size()) == 0);
+    char buffer[8];
+    assert(parent.read(buffer, sizeof(buffer)) == 0);
+    ::munmap(&header, sizeof(header));
+  }
+
+  {
+    //! the channel is shared with a child process
+    auto created = cu0::Channel::create(4096);
+    assert(std::holds_alternative<cu0::Channel>(created));
+    auto& channel = std::get<cu0::Channel>(created);
+    auto process_variant = cu0::Process::create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "echo", std::to_string(channel.fd()), },
+        },
+        channel
+    );
+    assert(std::holds_alternative<cu0::Process>(process_variant));
+    auto& process = std::get<cu0::Process>(process_variant);
+    auto data = std::string{};
+    for (auto i = 0; i < 50000; i++) {
+      data += static_cast<char>('0' + i % 10);
+    }
+    auto writer = std::thread([&channel, &data](){
+      assert(channel.write(data.data(), data.size()) == data.size());
+    });
+    auto received = std::string{};
+    char chunk[1000];
+    while (received.size() < data.size()) {
+      const auto bytes = channel.read(chunk, sizeof(chunk));
+      assert(bytes != 0);
+      received.append(chunk, bytes);
+    }
+    writer.join();
+    assert(received == data);
+    channel.close();
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 0);
+  }
+
+  {
+    //! the channel is not inherited by processes created without it
+    auto created = cu0::Channel::create(4096);
+    assert(std::holds_alternative<cu0::Channel>(created));
+    const auto& channel = std::get<cu0::Channel>(created);
+    auto process_variant = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "echo", std::to_string(channel.fd()), },
+    });
+    assert(std::holds_alternative<cu0::Process>(process_variant));
+    auto& process = std::get<cu0::Process>(process_variant);
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 1);
+  }
+#else
+  (void)argc;
+  (void)argv;
+#warning <linux/futex.h> or <sys/mman.h> or <sys/syscall.h> is not found => \
+cu0::Channel will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+#include <cu0/platform/cpu_topology.hh>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#if __has_include(<unistd.h>)
+  #include <unistd.h> //! for a unique directory name
+#endif
+
+//! writes a line into a file creating its directories
+void write(const std::filesystem::path& file, const std::string& line) {
+  std::filesystem::create_directories(file.parent_path());
+  auto stream = std::ofstream{file};
+  stream << line << '\n';
+}
+
+int main() {
+  const auto directory = std::filesystem::temp_directory_path() /
+#if __has_include(<unistd.h>)
+      ("cu0_check_cpu_topology_" + std::to_string(::getpid()));
+#else
+      "cu0_check_cpu_topology";
+#endif
+  {
+    //! no list of online cpus
+    const auto read_variant = cu0::CpuTopology::read(directory);
+    assert(std::holds_alternative<cu0::CpuTopology::ReadError>(read_variant));
+    assert(
+        std::get<cu0::CpuTopology::ReadError>(read_variant) ==
+            cu0::CpuTopology::ReadError::NOENT
+    );
+  }
+  {
+    //! malformed list of online cpus
+    write(directory / "online", "0-");
+    const auto read_variant = cu0::CpuTopology::read(directory);
+    assert(std::holds_alternative<cu0::CpuTopology::ReadError>(read_variant));
+    assert(
+        std::get<cu0::CpuTopology::ReadError>(read_variant) ==
+            cu0::CpuTopology::ReadError::INVAL
+    );
+  }
+  {
+    //! no topology, cache, nor node => a core per cpu, one cache, one node
+    write(directory / "online", "0-1");
+    const auto read_variant = cu0::CpuTopology::read(directory);
+    assert(std::holds_alternative<cu0::CpuTopology>(read_variant));
+    const auto& topology = std::get<cu0::CpuTopology>(read_variant);
+    assert(topology.cpus().size() == 2);
+    assert(topology.cores().size() == 2);
+    assert(topology.caches().size() == 1);
+    assert(topology.nodes().size() == 1);
+  }
+  //! 2 nodes, a last level cache per node, 2 cores per cache,
+  //!     2 SMT siblings per core: cpu i and cpu i + 4
+  write(directory / "online", "0-7");
+  for (auto i = 0; i < 8; i++) {
+    const auto cpu = directory / ("cpu" + std::to_string(i));
+    const auto core = i % 4;
+    const auto node = core / 2;
+    write(
+        cpu / "topology/thread_siblings_list",
+        std::to_string(core) + "," + std::to_string(core + 4)
+    );
+    write(cpu / "cache/index0/level", "1");
+    write(cpu / "cache/index0/type", "Data");
+    write(cpu / "cache/index0/shared_cpu_list", std::to_string(i));
+    write(cpu / "cache/index1/level", "1");
+    write(cpu / "cache/index1/type", "Instruction");
+    write(cpu / "cache/index1/shared_cpu_list", std::to_string(i));
+    write(cpu / "cache/index2/level", "3");
+    write(cpu / "cache/index2/type", "Unified");
+    write(
+        cpu / "cache/index2/shared_cpu_list",
+        std::to_string(node * 2) + "-" + std::to_string(node * 2 + 1) + "," +
+            std::to_string(node * 2 + 4) + "-" + std::to_string(node * 2 + 5)
+    );
+    std::filesystem::create_directories(cpu / ("node" + std::to_string(node)));
+  }
+  {
+    const auto read_variant = cu0::CpuTopology::read(directory);
+    assert(std::holds_alternative<cu0::CpuTopology>(read_variant));
+    const auto& topology = std::get<cu0::CpuTopology>(read_variant);
+    assert(topology.cpus().size() == 8);
+    for (auto i = 0u; i < 8; i++) {
+      const auto& cpu = topology.cpus()[i];
+      assert(cpu.id == i);
+      assert(cpu.core == i % 4);
+      assert(cpu.cache == i % 4 / 2);
+      assert(cpu.node == i % 4 / 2);
+    }
+    using Group = std::vector<std::size_t>;
+    assert((
+        topology.cores() ==
+            std::vector<Group>{ { 0, 4, }, { 1, 5, }, { 2, 6, }, { 3, 7, }, }
+    ));
+    assert((
+        topology.caches() ==
+            std::vector<Group>{ { 0, 1, 4, 5, }, { 2, 3, 6, 7, }, }
+    ));
+    assert((
+        topology.nodes() ==
+            std::vector<Group>{ { 0, 1, 4, 5, }, { 2, 3, 6, 7, }, }
+    ));
+#if __has_include(<sched.h>)
+    {
+      //! first siblings before second ones, caches are interleaved
+      const auto expected = std::vector<int>{ 0, 2, 1, 3, 4, 6, 5, 7, 0, 2, };
+      const auto sets = topology.spread(
+          expected.size(),
+          cu0::CpuTopology::set_of({ 0, 1, 2, 3, 4, 5, 6, 7, })
+      );
+      assert(sets.size() == expected.size());
+      for (auto i = 0u; i < sets.size(); i++) {
+        assert(CPU_COUNT(&sets[i]) == 1);
+        assert(CPU_ISSET(expected[i], &sets[i]));
+      }
+    }
+    {
+      //! the cpus which are not allowed are skipped
+      const auto expected = std::vector<int>{ 2, 1, 6, 2, };
+      const auto sets = topology.spread(
+          expected.size(),
+          cu0::CpuTopology::set_of({ 1, 2, 6, })
+      );
+      assert(sets.size() == expected.size());
+      for (auto i = 0u; i < sets.size(); i++) {
+        assert(CPU_COUNT(&sets[i]) == 1);
+        assert(CPU_ISSET(expected[i], &sets[i]));
+      }
+      //! no allowed cpu of the topology
+      assert(topology.spread(4, cu0::CpuTopology::set_of({ 8, })).empty());
+    }
+    {
+      const auto set = cu0::CpuTopology::set_of(topology.cores()[1]);
+      assert(CPU_COUNT(&set) == 2);
+      assert(CPU_ISSET(1, &set));
+      assert(CPU_ISSET(5, &set));
+    }
+#else
+#warning <sched.h> is not found => \
+cu0::CpuTopology::spread(const std::size_t&) will not be checked
+#warning <sched.h> is not found => \
+cu0::CpuTopology::set_of(const std::vector<std::size_t>&) will not be checked
+#endif
+  }
+  std::filesystem::remove_all(directory);
+
+  //! the topology of this machine
+  if (std::filesystem::exists("/sys/devices/system/cpu/online")) {
+    const auto read_variant = cu0::CpuTopology::read();
+    assert(std::holds_alternative<cu0::CpuTopology>(read_variant));
+    const auto& topology = std::get<cu0::CpuTopology>(read_variant);
+    assert(!topology.cpus().empty());
+    assert(!topology.cores().empty());
+    assert(topology.cores().size() <= topology.cpus().size());
+    assert(!topology.caches().empty());
+    assert(!topology.nodes().empty());
+#if __has_include(<sched.h>)
+    //! only the cpus the process may run on are used
+    auto allowed = cpu_set_t{};
+    assert(::sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    const auto sets = topology.spread(topology.cpus().size() * 2);
+    assert(!sets.empty());
+    for (const auto& set : sets) {
+      assert(CPU_COUNT(&set) == 1);
+      auto both = cpu_set_t{};
+      CPU_AND(&both, &set, &allowed);
+      assert(CPU_COUNT(&both) == 1);
+    }
+#endif
+  }
+
+  return 0;
+}
@@ -3,8 +3,12 @@
 
 #if __has_include(<unistd.h>)
 #include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory_resource>
 #include <set>
 #include <string>
+#include <string_view>
 #endif
 
 #if __has_include(<unistd.h>)
@@ -37,6 +41,38 @@ int main() {
       assert(set.contains(actual_string));
     }
   }
+  {
+    const auto environment = cu0::Environment::as<cu0::EnvironmentView>();
+    auto size = 0u;
+    for (char** envp = environ; *envp != NULL; envp++) {
+      size++;
+    }
+    assert(environment.size() == size);
+    auto envp = environ;
+    for (const auto& [key, value] : environment) {
+      assert(std::string{key} + "=" + std::string{value} == *envp);
+      const auto* raw = std::getenv(std::string{key}.c_str());
+      assert(raw != NULL);
+      assert(environment.find(key).value() == raw);
+      envp++;
+    }
+    assert(!environment.find("CU0_NOT_AN_ENVIRONMENT_VARIABLE").has_value());
+  }
+  {
+    auto arena = std::pmr::monotonic_buffer_resource{};
+    const auto environment = cu0::Environment::as<
+        std::pmr::map<std::pmr::string, std::pmr::string>
+    >(&arena);
+    const auto expected =
+        cu0::Environment::as<std::map<std::string, std::string>>();
+    assert(environment.size() == expected.size());
+    for (const auto& [key, value] : environment) {
+      assert(expected.at(std::string{key}) == std::string_view{value});
+      //! the strings are allocated by the arena too
+      assert(key.get_allocator().resource() == &arena);
+      assert(value.get_allocator().resource() == &arena);
+    }
+  }
 #else
 #warning <unistd.h> is not found => \
 template <class T> cu0::Environment::as<T>() will not be checked
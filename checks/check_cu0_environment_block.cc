@@ -0,0 +1,54 @@
+#include <cu0/env/environment_block.hh>
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+int main() {
+  {
+    const auto block = cu0::EnvironmentBlock::of(
+        std::map<std::string, std::string>{
+          { "key1", "value1", },
+          { "key2", "", },
+        }
+    );
+    assert(block.size() == 2);
+    assert(std::string{block.envp()[0]} == "key1=value1");
+    assert(std::string{block.envp()[1]} == "key2=");
+    assert(block.envp()[2] == nullptr);
+    assert(block.view().find("key1").value() == "value1");
+    assert(block.view().find("key2").value().empty());
+  }
+  {
+    const auto block = cu0::EnvironmentBlock::of(
+        std::map<std::string, std::string>{}
+    );
+    assert(block.size() == 0);
+    assert(block.envp()[0] == nullptr);
+  }
+  {
+    char key2[] = "key2=value2";
+    char key1[] = "key1=value1";
+    char* envp[] = { key2, key1, nullptr, };
+    const auto block = cu0::EnvironmentBlock::of(cu0::EnvironmentView::of(envp));
+    //! the order of the environment is kept and the strings are copied
+    assert(block.size() == 2);
+    assert(std::string{block.envp()[0]} == "key2=value2");
+    assert(block.envp()[0] != key2);
+    key2[0] = 'K';
+    assert(block.view().find("key2").value() == "value2");
+  }
+#if __has_include(<unistd.h>)
+  {
+    ::setenv("CU0_CHECK_BLOCK", "before", true);
+    const auto block = cu0::EnvironmentBlock::current();
+    ::setenv("CU0_CHECK_BLOCK", "after", true);
+    //! a block is immutable and copies share the environment vector
+    const auto copy = block;
+    assert(copy.envp() == block.envp());
+    assert(copy.view().find("CU0_CHECK_BLOCK").value() == "before");
+    ::unsetenv("CU0_CHECK_BLOCK");
+  }
+#endif
+  return 0;
+}
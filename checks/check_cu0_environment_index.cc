@@ -0,0 +1,92 @@
+#include <cu0/env/environment_index.hh>
+#include <cu0/env/environment_variable.hh>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main() {
+  {
+    const auto index =
+        cu0::EnvironmentIndex::of(cu0::EnvironmentView::of(nullptr));
+    assert(index.size() == 0);
+    assert(!index.find("key").has_value());
+  }
+  {
+    char key1[] = "key1=value1";
+    char key2[] = "key2=";
+    char duplicate[] = "key1=duplicate";
+    char no_delimeter[] = "no_delimeter";
+    char* envp[] = { key1, key2, duplicate, no_delimeter, nullptr, };
+    const auto index =
+        cu0::EnvironmentIndex::of(cu0::EnvironmentView::of(envp));
+    assert(index.size() == 3);
+    assert(index.find("key1").value() == "value1");
+    assert(index.find("key2").value().empty());
+    assert(!index.find("key").has_value());
+    assert(!index.find("key3").has_value());
+  }
+  {
+    //! many keys for collisions
+    auto strings = std::vector<std::string>{};
+    for (auto i = 0; i < 1000; i++) {
+      strings.push_back("key" + std::to_string(i) + "=" + std::to_string(i));
+    }
+    auto envp = std::vector<char*>{};
+    for (auto& string : strings) {
+      envp.push_back(string.data());
+    }
+    envp.push_back(nullptr);
+    const auto index =
+        cu0::EnvironmentIndex::of(cu0::EnvironmentView::of(envp.data()));
+    assert(index.size() == 1000);
+    for (auto i = 0; i < 1000; i++) {
+      assert(
+          index.find("key" + std::to_string(i)).value() == std::to_string(i)
+      );
+    }
+    assert(!index.find("key1000").has_value());
+  }
+#if __has_include(<unistd.h>) && !defined(NOT_AN_X)
+  {
+    auto i = 0;
+    auto key = std::string{"CU0_CHECK_ENVIRONMENT_INDEX"};
+    while (std::getenv(key.c_str()) != NULL) {
+      key = "CU0_CHECK_ENVIRONMENT_INDEX" + std::to_string(++i);
+    }
+    assert(!cu0::EnvironmentIndex::current().find(key).has_value());
+    auto variable = cu0::EnvironmentVariable::unsynced(key);
+    //! the index is rebuilt after a modification
+    assert(std::holds_alternative<std::monostate>(variable.set("value")));
+    assert(cu0::EnvironmentIndex::current().find(key).value() == "value");
+    assert(std::holds_alternative<std::monostate>(variable.set("next")));
+    assert(cu0::EnvironmentIndex::current().find(key).value() == "next");
+    const auto* path = std::getenv("PATH");
+    if (path != NULL) {
+      assert(cu0::EnvironmentIndex::current().find("PATH").value() == path);
+    }
+    assert(std::holds_alternative<std::monostate>(variable.unset()));
+    assert(!cu0::EnvironmentIndex::current().find(key).has_value());
+    //! modifications made without cu0 are detected by find_current()
+    ::setenv(key.c_str(), "raw", true);
+    assert(cu0::EnvironmentIndex::find_current(key).value() == "raw");
+    ::setenv(key.c_str(), "replaced", true);
+    assert(cu0::EnvironmentIndex::find_current(key).value() == "replaced");
+    auto other = key + "_OTHER";
+    ::setenv(other.c_str(), "other", true);
+    assert(cu0::EnvironmentIndex::find_current(other).value() == "other");
+    ::unsetenv(key.c_str());
+    assert(!cu0::EnvironmentIndex::find_current(key).has_value());
+    assert(cu0::EnvironmentIndex::find_current(other).value() == "other");
+    ::unsetenv(other.c_str());
+    assert(!cu0::EnvironmentIndex::find_current(other).has_value());
+    if (path != NULL) {
+      assert(cu0::EnvironmentIndex::find_current("PATH").value() == path);
+    }
+  }
+#else
+#warning <unistd.h> is not found or NOT_AN_X is defined => \
+cu0::EnvironmentIndex::current() will not be checked
+#endif
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <cu0/env/environment_keys.hh>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+static constexpr auto KEYS = std::to_array<std::string_view>({
+  "CU0_CHECK_KEY_0",
+  "CU0_CHECK_KEY_1",
+  "CU0_CHECK_KEY_2",
+  "CU0_CHECK_NOT_SET",
+});
+
+//! many keys for the perfect hash to have collisions of buckets
+static constexpr auto MANY_KEYS = [] {
+  auto ret = std::array<std::string_view, 64>{};
+  constexpr std::string_view NAMES =
+      "A0A1A2A3A4A5A6A7A8A9B0B1B2B3B4B5B6B7B8B9C0C1C2C3C4C5C6C7C8C9D0D1"
+      "D2D3D4D5D6D7D8D9E0E1E2E3E4E5E6E7E8E9F0F1F2F3F4F5F6F7F8F9G0G1G2G3";
+  for (auto i = 0u; i < ret.size(); i++) {
+    ret[i] = NAMES.substr(i * 2, 2);
+  }
+  return ret;
+}();
+
+int main() {
+  using Keys = cu0::EnvironmentKeys<KEYS>;
+  //! indices are constants
+  static_assert(Keys::size() == 4);
+  static_assert(Keys::index_of("CU0_CHECK_KEY_0").value() == 0);
+  static_assert(Keys::index_of("CU0_CHECK_NOT_SET").value() == 3);
+  static_assert(!Keys::index_of("CU0_CHECK_KEY").has_value());
+  static_assert(!Keys::index_of("").has_value());
+  using ManyKeys = cu0::EnvironmentKeys<MANY_KEYS>;
+  static_assert([] {
+    for (auto i = 0u; i < MANY_KEYS.size(); i++) {
+      if (ManyKeys::index_of(MANY_KEYS[i]) != i) {
+        return false;
+      }
+    }
+    return !ManyKeys::index_of("G4").has_value();
+  }());
+#if __has_include(<unistd.h>)
+  ::setenv("CU0_CHECK_KEY_0", "value0", true);
+  ::setenv("CU0_CHECK_KEY_2", "value2", true);
+  ::unsetenv("CU0_CHECK_KEY_1");
+  ::unsetenv("CU0_CHECK_NOT_SET");
+  auto keys = Keys::synced();
+  assert(keys.at(0).key() == "CU0_CHECK_KEY_0");
+  assert(keys.at(0).cached().value() == "value0");
+  assert(!keys.at(1).cached().has_value());
+  assert(keys.find("CU0_CHECK_KEY_2")->cached().value() == "value2");
+  assert(keys.find("CU0_CHECK_KEY_2") == &keys.at(2));
+  assert(keys.find("PATH") == nullptr);
+  ::setenv("CU0_CHECK_KEY_1", "value1", true);
+  ::unsetenv("CU0_CHECK_KEY_0");
+  //! the cached values are kept until synced
+  assert(!keys.at(1).cached().has_value());
+  keys.sync();
+  assert(!keys.at(0).is_stale());
+  assert(!keys.at(0).cached().has_value());
+  assert(keys.at(1).cached().value() == "value1");
+  assert(keys.at(1).key() == "CU0_CHECK_KEY_1");
+  ::unsetenv("CU0_CHECK_KEY_1");
+  ::unsetenv("CU0_CHECK_KEY_2");
+#endif
+  return 0;
+}
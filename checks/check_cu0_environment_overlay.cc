@@ -0,0 +1,101 @@
+#include <cu0/env/environment_overlay.hh>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+int main() {
+  char key1[] = "key1=value1";
+  char key2[] = "key2=value2";
+  char duplicate[] = "key2=duplicate";
+  char key3[] = "key3=value3";
+  char* envp[] = { key1, key2, duplicate, key3, nullptr, };
+  const auto base = cu0::EnvironmentView::of(envp);
+  const auto to_strings = [](const std::vector<char*>& envp) {
+    assert(!envp.empty());
+    assert(envp.back() == nullptr);
+    auto ret = std::vector<std::string>{};
+    for (auto i = 0u; i + 1 < envp.size(); i++) {
+      ret.emplace_back(envp[i]);
+    }
+    return ret;
+  };
+  {
+    const auto overlay = cu0::EnvironmentOverlay::of(base);
+    const auto overlay_envp = overlay.envp();
+    //! the strings of the base are not copied
+    assert(overlay_envp.size() == 5);
+    assert(overlay_envp[0] == key1);
+    assert(overlay_envp[3] == key3);
+    assert(overlay.find("key2").value() == "value2");
+  }
+  {
+    auto overlay = cu0::EnvironmentOverlay::of(base);
+    overlay
+        .set("key2", "new")
+        .unset("key3")
+        .set("key4", "value4")
+        .set("key5", "value5")
+        .unset("key5")
+        .unset("key6");
+    assert(overlay.find("key1").value() == "value1");
+    assert(overlay.find("key2").value() == "new");
+    assert(!overlay.find("key3").has_value());
+    assert(overlay.find("key4").value() == "value4");
+    assert(!overlay.find("key5").has_value());
+    const auto overlay_envp = overlay.envp();
+    assert(overlay_envp[0] == key1);
+    assert((
+        to_strings(overlay_envp) == std::vector<std::string>{
+          "key1=value1",
+          "key2=new",
+          "key4=value4",
+        }
+    ));
+    {
+      //! the vector and the memory used to create it are from the resource
+      auto buffer = std::array<std::byte, 1 << 10>{};
+      auto arena = std::pmr::monotonic_buffer_resource{
+        buffer.data(),
+        buffer.size(),
+        std::pmr::null_memory_resource(),
+      };
+      const auto pmr_envp = overlay.envp(&arena);
+      assert(pmr_envp.get_allocator().resource() == &arena);
+      assert((
+          std::vector<char*>{pmr_envp.begin(), pmr_envp.end()} == overlay_envp
+      ));
+    }
+    //! modifications replace each other
+    overlay.set("key3", "again");
+    assert((
+        to_strings(overlay.envp()) == std::vector<std::string>{
+          "key1=value1",
+          "key2=new",
+          "key3=again",
+          "key4=value4",
+        }
+    ));
+  }
+#if __has_include(<unistd.h>) && !defined(NOT_AN_X)
+  {
+    auto overlay = cu0::EnvironmentOverlay::current();
+    ::setenv("CU0_CHECK_ENVIRONMENT_OVERLAY", "value", true);
+    //! environ is read when used
+    assert(
+        overlay.find("CU0_CHECK_ENVIRONMENT_OVERLAY").value() == "value"
+    );
+    overlay.unset("CU0_CHECK_ENVIRONMENT_OVERLAY");
+    for (const auto& entry : to_strings(overlay.envp())) {
+      assert(!entry.starts_with("CU0_CHECK_ENVIRONMENT_OVERLAY="));
+    }
+    ::unsetenv("CU0_CHECK_ENVIRONMENT_OVERLAY");
+  }
+#else
+#warning <unistd.h> is not found or NOT_AN_X is defined => \
+cu0::EnvironmentOverlay::current() will not be checked
+#endif
+  return 0;
+}
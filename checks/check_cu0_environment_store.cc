@@ -0,0 +1,123 @@
+#include <cu0/env/environment_store.hh>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+#if __has_include(<unistd.h>)
+  auto& store = cu0::EnvironmentStore::instance();
+  assert(&store == &cu0::EnvironmentStore::instance());
+  //! snapshots loaded by the reader are not freed before it is quiescent
+  auto registered = cu0::EnvironmentStore::Reader{store};
+
+  //! the store is a copy of environ
+  {
+    const auto& snapshot = registered.load();
+    auto size = 0u;
+    for (char** envp = environ; *envp != NULL; envp++) {
+      size++;
+    }
+    assert(snapshot.view().size() == size);
+    const auto* path = std::getenv("PATH");
+    if (path != NULL) {
+      assert(snapshot.find("PATH").value() == path);
+    }
+  }
+
+  auto i = 0;
+  auto key = std::string{"CU0_CHECK_ENVIRONMENT_STORE"};
+  while (registered.load().find(key).has_value()) {
+    key = "CU0_CHECK_ENVIRONMENT_STORE" + std::to_string(++i);
+  }
+
+  const auto& before = registered.load();
+  assert(std::holds_alternative<std::monostate>(store.set(key, "value")));
+  const auto& after = registered.load();
+  assert(&before != &after);
+  //! snapshots are immutable
+  assert(!before.find(key).has_value());
+  assert(after.find(key).value() == "value");
+  assert(std::getenv(key.c_str()) == NULL);
+  //! the environment block can be passed to ::execve()
+  auto found = false;
+  for (auto envp = after.envp(); *envp != nullptr; envp++) {
+    found = found || std::string{*envp} == key + "=value";
+  }
+  assert(found);
+
+  //! nothing is published if nothing changes
+  assert(std::holds_alternative<std::monostate>(store.set(key, "value")));
+  assert(&registered.load() == &after);
+
+  assert(
+      std::get<cu0::EnvironmentStore::SetError>(store.set("", "value")) ==
+          cu0::EnvironmentStore::SetError::INVALID
+  );
+  assert(
+      std::get<cu0::EnvironmentStore::SetError>(store.unset("a=b")) ==
+          cu0::EnvironmentStore::SetError::INVALID
+  );
+
+  //! readers and a writer run concurrently
+  {
+    auto stop = std::atomic<bool>{false};
+    auto readers = std::vector<std::thread>{};
+    for (auto j = 0; j < 4; j++) {
+      readers.emplace_back([&] {
+        auto concurrent = cu0::EnvironmentStore::Reader{store};
+        while (!stop.load()) {
+          const auto value = concurrent.load().find(key);
+          assert(value.has_value());
+          assert(value.value().starts_with("value"));
+          concurrent.quiescent();
+        }
+      });
+    }
+    for (auto j = 0; j < 100; j++) {
+      assert(
+          std::holds_alternative<std::monostate>(
+              store.set(key, "value" + std::to_string(j))
+          )
+      );
+    }
+    stop = true;
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    assert(registered.load().find(key).value() == "value99");
+  }
+
+  assert(std::holds_alternative<std::monostate>(store.unset(key)));
+  assert(!registered.load().find(key).has_value());
+  assert(after.find(key).value() == "value");
+
+  //! the replaced snapshots are kept while the reader may use them
+  assert(store.retained() == 102);
+  registered.quiescent();
+  assert(store.retained() == 102);
+  //! freed by the next modification except for the one replaced by it
+  assert(std::holds_alternative<std::monostate>(store.set(key, "value")));
+  assert(store.retained() == 1);
+  {
+    //! a reader registered later does not hold the snapshots replaced before
+    auto later = cu0::EnvironmentStore::Reader{store};
+    registered.quiescent();
+    assert(std::holds_alternative<std::monostate>(store.unset(key)));
+    assert(store.retained() == 1);
+    const auto& snapshot = later.load();
+    assert(std::holds_alternative<std::monostate>(store.set(key, "value")));
+    assert(store.retained() == 2);
+    assert(!snapshot.find(key).has_value());
+  }
+  registered.quiescent();
+  assert(std::holds_alternative<std::monostate>(store.unset(key)));
+  assert(store.retained() == 1);
+#else
+#warning <unistd.h> is not found => \
+cu0::EnvironmentStore will not be checked
+#endif
+  return 0;
+}
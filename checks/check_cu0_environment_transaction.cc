@@ -0,0 +1,74 @@
+#include <cu0/env/environment_index.hh>
+#include <cu0/env/environment_transaction.hh>
+#include <cu0/env/environment_variable.hh>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <variant>
+
+int main() {
+#if __has_include(<unistd.h>)
+  ::setenv("CU0_CHECK_REPLACED", "old", true);
+  ::setenv("CU0_CHECK_UNSET", "value", true);
+  ::setenv("CU0_CHECK_KEPT", "kept", true);
+  ::unsetenv("CU0_CHECK_NEW");
+  const auto variable = cu0::EnvironmentVariable::synced("CU0_CHECK_KEPT");
+  {
+    const auto generation = cu0::EnvironmentVariable::generation();
+    auto transaction = cu0::EnvironmentTransaction::begin();
+    transaction
+        .set("CU0_CHECK_REPLACED", "first")
+        .set("CU0_CHECK_REPLACED", "new")
+        .unset("CU0_CHECK_UNSET")
+        .set("CU0_CHECK_NEW", "new")
+        .unset("CU0_CHECK_NOT_SET");
+    //! nothing is applied before commit
+    assert(std::string{std::getenv("CU0_CHECK_REPLACED")} == "old");
+    assert(std::getenv("CU0_CHECK_NEW") == NULL);
+    assert(std::holds_alternative<std::monostate>(transaction.commit()));
+    //! one modification for all the changes
+    assert(cu0::EnvironmentVariable::generation() == generation + 1);
+    assert(variable.is_stale());
+    assert(std::string{std::getenv("CU0_CHECK_REPLACED")} == "new");
+    assert(std::string{std::getenv("CU0_CHECK_NEW")} == "new");
+    assert(std::getenv("CU0_CHECK_UNSET") == NULL);
+    assert(std::string{std::getenv("CU0_CHECK_KEPT")} == "kept");
+    assert(
+        cu0::EnvironmentIndex::current().find("CU0_CHECK_NEW").value() == "new"
+    );
+    //! the changes are discarded after commit
+    assert(std::holds_alternative<std::monostate>(transaction.commit()));
+    assert(cu0::EnvironmentVariable::generation() == generation + 1);
+  }
+  {
+    const auto* value = std::getenv("CU0_CHECK_NEW");
+    auto transaction = cu0::EnvironmentTransaction::begin();
+    transaction.set("CU0_CHECK_NEW", "newer").set("", "invalid");
+    assert(
+        std::get<cu0::EnvironmentTransaction::CommitError>(
+            transaction.commit()
+        ) == cu0::EnvironmentTransaction::CommitError::INVALID
+    );
+    //! nothing is applied if a key is invalid
+    assert(std::string{std::getenv("CU0_CHECK_NEW")} == "new");
+    transaction = cu0::EnvironmentTransaction::begin();
+    transaction.set("CU0_CHECK_NEW", "newer");
+    assert(std::holds_alternative<std::monostate>(transaction.commit()));
+    assert(std::string{std::getenv("CU0_CHECK_NEW")} == "newer");
+    //! a value returned before stays valid
+    assert(std::string{value} == "new");
+  }
+  {
+    //! ::setenv() and ::unsetenv() work after a commit
+    ::setenv("CU0_CHECK_AFTER", "after", true);
+    ::unsetenv("CU0_CHECK_KEPT");
+    assert(std::string{std::getenv("CU0_CHECK_AFTER")} == "after");
+    assert(std::string{std::getenv("CU0_CHECK_NEW")} == "newer");
+    assert(std::getenv("CU0_CHECK_KEPT") == NULL);
+  }
+  ::unsetenv("CU0_CHECK_REPLACED");
+  ::unsetenv("CU0_CHECK_NEW");
+  ::unsetenv("CU0_CHECK_AFTER");
+#endif
+  return 0;
+}
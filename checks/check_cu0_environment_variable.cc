@@ -1,5 +1,8 @@
 #include <cu0/env/environment_variable.hh>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <vector>
 
 int main() {
   constexpr auto TEST_KEY = "test_key";
@@ -59,8 +62,27 @@ int main() {
   assert(environment_variable.sync().has_value());
   assert(environment_variable.sync().value() == TEST_VALUE);
 
+  {
+    auto variables = std::vector<cu0::EnvironmentVariable>{
+      cu0::EnvironmentVariable::unsynced(unique_test_key),
+      cu0::EnvironmentVariable::unsynced({
+        .key = another_unique_test_key + "_not_set",
+        .value = "stale",
+      }),
+      cu0::EnvironmentVariable::unsynced(another_unique_test_key),
+      cu0::EnvironmentVariable::unsynced(unique_test_key),
+    };
+    cu0::EnvironmentVariable::sync(variables);
+    assert(variables[0].cached().value() == TEST_VALUE);
+    assert(!variables[1].cached().has_value());
+    assert(variables[2].cached().value() == ANOTHER_TEST_VALUE2);
+    assert(variables[3].cached().value() == TEST_VALUE);
+  }
+
 #if !defined(NOT_AN_X)
+  const auto generation = cu0::EnvironmentVariable::generation();
   const auto set_variant = environment_variable.set(TEST_VALUE_NEXT);
+  assert(cu0::EnvironmentVariable::generation() == generation + 1);
   assert(std::holds_alternative<std::monostate>(set_variant));
   assert(environment_variable.key() == unique_test_key);
   assert(environment_variable.cached().has_value());
@@ -69,12 +91,107 @@ int main() {
   assert(environment_variable.sync().value() == TEST_VALUE_NEXT);
 
   const auto unset_variant = environment_variable.unset();
+  assert(cu0::EnvironmentVariable::generation() == generation + 2);
   assert(std::holds_alternative<std::monostate>(unset_variant));
   assert(environment_variable.key() == unique_test_key);
   assert(!environment_variable.cached().has_value());
   assert(!environment_variable.sync().has_value());
 #endif
 
+  {
+    const auto of = [](const char* value) {
+      return cu0::EnvironmentVariable::unsynced(cu0::EnvironmentVariableData{
+        .key = "key",
+        .value = value,
+      });
+    };
+    assert(of("42").as<int>().value() == 42);
+    assert(of("-42").as<long>().value() == -42);
+    assert(!of("-1").as<unsigned>().has_value());
+    assert(!of("300").as<std::uint8_t>().has_value());
+    assert(!of("42abc").as<int>().has_value());
+    assert(!of("").as<int>().has_value());
+    assert(of("0.5").as<double>().value() == 0.5);
+    assert(!of("0.5.").as<double>().has_value());
+    assert(of("true").as<bool>().value());
+    assert(of("on").as<bool>().value());
+    assert(!of("0").as<bool>().value());
+    assert(!of("maybe").as<bool>().has_value());
+    using namespace std::chrono_literals;
+    assert(of("1500ms").as<std::chrono::milliseconds>().value() == 1500ms);
+    assert(of("2min").as<std::chrono::seconds>().value() == 120s);
+    assert(of("1500ms").as<std::chrono::seconds>().value() == 1s);
+    //! the unit of the duration type is used if there is no unit
+    assert(of("3").as<std::chrono::seconds>().value() == 3s);
+    assert(!of("3days").as<std::chrono::seconds>().has_value());
+    //! a value which does not fit the representation of T is not parsed
+    using IntMilliseconds = std::chrono::duration<int, std::milli>;
+    using IntNanoseconds = std::chrono::duration<int, std::nano>;
+    assert(!of("5000000000").as<IntMilliseconds>().has_value());
+    assert(!of("-5000000000").as<IntMilliseconds>().has_value());
+    assert(of("2000000000").as<IntMilliseconds>().value().count() == 2e9);
+    assert(!of("10s").as<IntNanoseconds>().has_value());
+    assert(!of("-10s").as<IntNanoseconds>().has_value());
+    assert(of("2s").as<IntNanoseconds>().value().count() == 2e9);
+    assert(!of("1e39").as<float>().has_value());
+    assert(!of("-1e39").as<float>().has_value());
+    assert(of("1e38").as<float>().has_value());
+    assert(of("1e39").as<double>().has_value());
+    assert(!cu0::EnvironmentVariable::unsynced("key").as<int>().has_value());
+
+    auto path = of("/bin::/usr/bin");
+    const auto& parts = path.split();
+    assert((parts == std::vector<std::string_view>{ "/bin", "", "/usr/bin", }));
+    //! the parts are cached
+    assert(&path.split() == &parts);
+    assert(path.split(',').size() == 1);
+    assert(cu0::EnvironmentVariable::unsynced("key").split().empty());
+    //! parts of a copy refer to the copy
+    const auto copy = path;
+    assert(copy.split()[0].data() == copy.cached().value().data());
+
+    //! the parsed value is reset when the value changes
+    auto variable = cu0::EnvironmentVariable::unsynced(unique_test_key);
+    setenv(unique_test_key.c_str(), "1", true);
+    variable.sync();
+    assert(variable.as<int>().value() == 1);
+    setenv(unique_test_key.c_str(), "2", true);
+    assert(variable.as<int>().value() == 1);
+    variable.sync();
+    assert(variable.as<int>().value() == 2);
+#if !defined(NOT_AN_X)
+    assert(std::holds_alternative<std::monostate>(variable.set("3")));
+    assert(variable.as<int>().value() == 3);
+#endif
+  }
+
+#if !defined(NOT_AN_X)
+  {
+    auto variable = cu0::EnvironmentVariable::unsynced(unique_test_key);
+    //! never synced
+    assert(variable.is_stale());
+    variable.sync();
+    assert(!variable.is_stale());
+    auto other = cu0::EnvironmentVariable::synced(another_unique_test_key);
+    assert(!other.is_stale());
+    //! a modification by any instance makes the others stale
+    assert(std::holds_alternative<std::monostate>(variable.set("value")));
+    assert(!variable.is_stale());
+    assert(other.is_stale());
+    other.sync();
+    assert(!other.is_stale());
+    assert(std::holds_alternative<std::monostate>(other.unset()));
+    assert(!other.is_stale());
+    assert(variable.is_stale());
+    auto variables = std::vector<cu0::EnvironmentVariable>{
+      cu0::EnvironmentVariable::unsynced(unique_test_key),
+    };
+    assert(variables[0].is_stale());
+    cu0::EnvironmentVariable::sync(variables);
+    assert(!variables[0].is_stale());
+  }
+#endif
+
   unsetenv(unique_test_key.c_str());
   unsetenv(another_unique_test_key.c_str());
 
@@ -0,0 +1,49 @@
+#include <cu0/env/environment_view.hh>
+#include <cassert>
+#include <string_view>
+
+int main() {
+  {
+    const auto view = cu0::EnvironmentView::of(nullptr);
+    assert(view.size() == 0);
+    assert(view.begin() == view.end());
+    assert(!view.find("key").has_value());
+  }
+  {
+    char key1[] = "key1=value1";
+    char key[] = "key=";
+    char no_delimeter[] = "no_delimeter";
+    char with_delimeter[] = "k=v=w";
+    char* envp[] = { key1, key, no_delimeter, with_delimeter, nullptr, };
+    const auto view = cu0::EnvironmentView::of(envp);
+    assert(view.size() == 4);
+
+    auto it = view.begin();
+    assert((*it).first == "key1");
+    assert((*it).second == "value1");
+    ++it;
+    assert((*it).first == "key");
+    assert((*it).second.empty());
+    it++;
+    assert((*it).first == "no_delimeter");
+    assert((*it).second.empty());
+    ++it;
+    assert((*it).first == "k");
+    assert((*it).second == "v=w");
+    ++it;
+    assert(it == view.end());
+
+    assert(view.find("key1").value() == "value1");
+    assert(view.find("key").value().empty());
+    assert(view.find("k").value() == "v=w");
+    assert(!view.find("ke").has_value());
+    assert(!view.find("key12").has_value());
+    assert(!view.find("no_delimeter").has_value());
+    assert(!view.find("").has_value());
+
+    //! the view refers to the block
+    key1[5] = 'V';
+    assert(view.find("key1").value() == "Value1");
+  }
+  return 0;
+}
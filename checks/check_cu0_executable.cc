@@ -1,7 +1,12 @@
 #include <cu0/proc/executable.hh>
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
 #include <cu0/platform/not_an_x.hh>
 
 int main() {
@@ -30,6 +35,54 @@ int main() {
   assert(unique_executable.arguments.empty());
   assert(unique_executable.environment.empty());
 
+  const auto scanned_executable = cu0::util::find_by(
+      unique_name,
+      std::filesystem::current_path(),
+      cu0::util::Lookup::SCAN
+  );
+  assert(scanned_executable.binary == unique_executable.binary);
+
+#if __has_include(<sys/stat.h>)
+  //! the file is not executable yet
+  assert(
+      cu0::util::find_by(
+          unique_name,
+          std::filesystem::current_path(),
+          cu0::util::Lookup::EXECUTABLE
+      ).binary.empty()
+  );
+  std::filesystem::permissions(
+      unique_name,
+      std::filesystem::perms::owner_exec,
+      std::filesystem::perm_options::add
+  );
+  assert(
+      cu0::util::find_by(
+          unique_name,
+          std::filesystem::current_path(),
+          cu0::util::Lookup::EXECUTABLE
+      ).binary == unique_executable.binary
+  );
+  //! a name which is not a file name is not found
+  assert(
+      cu0::util::find_by("..", std::filesystem::current_path()).binary.empty()
+  );
+#endif
+
+#if __has_include(<dirent.h>)
+  const auto names = std::vector<std::string>{
+    unique_name + "_not_found",
+    unique_name,
+    unique_name,
+  };
+  const auto executables =
+      cu0::util::find_by(names, std::filesystem::current_path());
+  assert(executables.size() == 3);
+  assert(executables[0].binary.empty());
+  assert(executables[1].binary == unique_executable.binary);
+  assert(executables[2].binary == unique_executable.binary);
+#endif
+
   std::filesystem::remove(unique_name);
 
   const auto removed_executable_in_the_current_directory =
@@ -74,6 +127,37 @@ int main() {
   }
 #endif
 
+  {
+    auto buffer = std::array<std::byte, 1024>{};
+    auto arena = std::pmr::monotonic_buffer_resource{
+      buffer.data(),
+      buffer.size(),
+      std::pmr::null_memory_resource(),
+    };
+    const auto executable = cu0::Executable{
+      .binary = "binary",
+      .arguments = { "arg1", "", },
+      .environment = { { "key1", "value1", }, { "key2", "", }, },
+    };
+    const auto [argv_strings, argv] = cu0::util::argv_of(executable, &arena);
+    assert(argv.size() == 4);
+    assert(std::string{argv[0]} == "binary");
+    assert(std::string{argv[1]} == "arg1");
+    assert(std::string{argv[2]}.empty());
+    assert(argv[3] == NULL);
+    assert(argv[0] == argv_strings.data());
+    const auto [envp_strings, envp] = cu0::util::envp_of(executable, &arena);
+    assert(envp.size() == 3);
+    assert(std::string{envp[0]} == "key1=value1");
+    assert(std::string{envp[1]} == "key2=");
+    assert(envp[2] == NULL);
+    assert(envp.get_allocator().resource() == &arena);
+    const auto [empty_strings, empty] =
+        cu0::util::envp_of(cu0::Executable{}, &arena);
+    assert(empty.size() == 1);
+    assert(empty[0] == NULL);
+  }
+
   const auto executable = cu0::Executable{};
 
   const auto argv_of_executable = cu0::util::argv_of(executable);
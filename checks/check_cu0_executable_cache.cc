@@ -0,0 +1,108 @@
+#include <cu0/proc/executable_cache.hh>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+int main() {
+
+#if __has_include(<sys/stat.h>) && !defined(NOT_AN_X)
+  const auto name = std::string{"check_cu0_executable_cache_"};
+  auto i = 0;
+  auto unique_name = name;
+  const auto temp = std::filesystem::temp_directory_path();
+  while (
+      std::filesystem::exists(unique_name) ||
+      std::filesystem::exists(temp / unique_name)
+  ) {
+    unique_name = name + std::to_string(++i);
+  }
+  //! the current directory is searched too => it is changed to a directory
+  //!     which is not modified by others
+  const auto current = std::filesystem::current_path();
+  const auto root = temp / unique_name;
+  const auto directory = root / "bin";
+  std::filesystem::create_directories(directory);
+  std::filesystem::current_path(root);
+  const auto binary = directory / unique_name;
+  //! a directory modified during a search is not cached =>
+  //!     modification times are moved to the past
+  const auto age = [&root, &directory] {
+    const auto past =
+        std::filesystem::file_time_type::clock::now() - std::chrono::hours{1};
+    std::filesystem::last_write_time(root, past);
+    std::filesystem::last_write_time(directory, past);
+  };
+
+  const auto path = cu0::EnvironmentVariable::synced("PATH");
+  auto path_variable = cu0::EnvironmentVariable::unsynced("PATH");
+  (void)path_variable.set(directory.string());
+
+  //! the directories are checked on every call
+  auto cache = cu0::ExecutableCache{std::chrono::nanoseconds{0}};
+  age();
+  assert(cache.find_by(unique_name).binary.empty());
+  assert(cache.size() == 1);
+  //! cached
+  assert(cache.find_by(unique_name).binary.empty());
+  assert(cache.size() == 1);
+
+  //! the directory is modified => searched again
+  std::ofstream{binary};
+  age();
+  assert(cache.find_by(unique_name).binary == binary);
+  assert(cache.find_by(unique_name).binary == binary);
+  assert(cache.size() == 1);
+
+  std::filesystem::remove(binary);
+  assert(cache.find_by(unique_name).binary.empty());
+
+  //! PATH is changed => searched again
+  std::ofstream{binary};
+  age();
+  assert(cache.find_by(unique_name).binary == binary);
+  (void)path_variable.set("/not/a/path");
+  assert(cache.find_by(unique_name).binary.empty());
+  (void)path_variable.set(directory.string());
+  assert(cache.find_by(unique_name).binary == binary);
+  assert(cu0::util::find_by_cached(unique_name).binary == binary);
+  //! an entry per value of PATH
+  assert(cache.size() == 2);
+
+  cache.clear();
+  assert(cache.size() == 0);
+
+  {
+    //! the directories are not checked again within the interval =>
+    //!     a removed executable is still returned
+    auto lazy = cu0::ExecutableCache{std::chrono::hours{1}};
+    assert(lazy.find_by(unique_name).binary == binary);
+    (void)path_variable.set("/not/a/path");
+    assert(lazy.find_by(unique_name).binary.empty());
+    (void)path_variable.set(directory.string());
+    std::filesystem::remove(binary);
+    assert(lazy.find_by(unique_name).binary == binary);
+    assert(lazy.size() == 2);
+    lazy.clear();
+    assert(lazy.find_by(unique_name).binary.empty());
+  }
+
+  std::filesystem::current_path(current);
+  std::filesystem::remove_all(root);
+  assert(cache.find_by(unique_name).binary.empty());
+  (void)path_variable.set("/not/a/path");
+  assert(cu0::util::find_by_cached(unique_name).binary.empty());
+
+  if (path.cached().has_value()) {
+    (void)path_variable.set(path.cached().value());
+  } else {
+    (void)path_variable.unset();
+  }
+#else
+#warning <sys/stat.h> is not found or NOT_AN_X is defined => \
+cu0::ExecutableCache will not be checked
+#endif
+
+  return 0;
+}
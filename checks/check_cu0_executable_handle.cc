@@ -0,0 +1,81 @@
+#include <cu0/proc/executable_handle.hh>
+#include <cu0/proc/process.hh>
+#include <cassert>
+#include <string>
+
+int main(int argc, char** argv) {
+  //! for subprocess check
+  if (argc > 1) {
+    //! argv[0] is Executable::binary
+    return std::string{argv[0]} == "not_a_path" ? std::stoi(argv[1]) : 255;
+  }
+
+#if \
+    __has_include(<fcntl.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/wait.h>)
+  const auto run = [](const cu0::ExecutableHandle& handle, const int& code) {
+    auto options = cu0::SpawnOptions{};
+    options.binary = handle.fd();
+    auto created = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = "not_a_path",
+          .arguments = { std::to_string(code), },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().has_value());
+    return process.exit_code().value();
+  };
+
+  {
+    const auto not_opened = cu0::ExecutableHandle::open("/not/a/path");
+    assert(std::holds_alternative<cu0::ExecutableHandle::OpenError>(not_opened));
+    assert(
+        std::get<cu0::ExecutableHandle::OpenError>(not_opened) ==
+            cu0::ExecutableHandle::OpenError::NOENT
+    );
+    auto opened = cu0::ExecutableHandle::open(argv[0]);
+    assert(std::holds_alternative<cu0::ExecutableHandle>(opened));
+    const auto& handle = std::get<cu0::ExecutableHandle>(opened);
+    assert(handle.fd() >= 0);
+    assert(run(handle, 3) == 3);
+    //! the handle can be reused
+    assert(run(handle, 4) == 4);
+    const auto moved = cu0::ExecutableHandle{
+      std::move(std::get<cu0::ExecutableHandle>(opened))
+    };
+    assert(moved.fd() >= 0);
+    assert(run(moved, 5) == 5);
+  }
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/sendfile.h>)
+  {
+    const auto not_loaded = cu0::ExecutableHandle::load("/not/a/path");
+    assert(std::holds_alternative<cu0::ExecutableHandle::OpenError>(not_loaded));
+    auto loaded = cu0::ExecutableHandle::load(argv[0]);
+    assert(std::holds_alternative<cu0::ExecutableHandle>(loaded));
+    const auto& handle = std::get<cu0::ExecutableHandle>(loaded);
+    assert(run(handle, 6) == 6);
+    assert(run(handle, 7) == 7);
+    //! the copy is sealed
+    const auto seals = ::fcntl(handle.fd(), F_GET_SEALS);
+    assert(seals >= 0);
+    assert((seals & F_SEAL_WRITE) != 0);
+    assert((seals & F_SEAL_SEAL) != 0);
+  }
+#else
+#warning <sys/mman.h> or <sys/sendfile.h> is not found => \
+cu0::ExecutableHandle::load() will not be checked
+#endif
+#else
+  (void)argv;
+#warning <fcntl.h> or <sys/syscall.h> or <sys/wait.h> is not found => \
+cu0::ExecutableHandle will not be checked
+#endif
+
+  return 0;
+}
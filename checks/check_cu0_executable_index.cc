@@ -0,0 +1,69 @@
+#include <cu0/proc/executable_index.hh>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+int main() {
+
+#if __has_include(<dirent.h>)
+  const auto name = std::string{"check_cu0_executable_index_"};
+  const auto temp = std::filesystem::temp_directory_path();
+  auto i = 0;
+  auto unique_name = name;
+  while (std::filesystem::exists(temp / unique_name)) {
+    unique_name = name + std::to_string(++i);
+  }
+  const auto root = temp / unique_name;
+  const auto directories = std::vector<std::filesystem::path>{
+    root / "first",
+    root / "not_a_directory",
+    root / "second",
+  };
+  std::filesystem::create_directories(directories[0]);
+  std::filesystem::create_directories(directories[2]);
+  std::ofstream{directories[0] / "shared"};
+  std::ofstream{directories[2] / "shared"};
+  std::ofstream{directories[2] / "only_second"};
+  std::ofstream{directories[0] / "only_first"};
+
+  const auto index = cu0::ExecutableIndex::create(directories);
+  assert(index.size() == 3);
+  assert(index.find_by("shared").binary == directories[0] / "shared");
+  assert(index.find_by("only_first").binary == directories[0] / "only_first");
+  assert(
+      index.find_by("only_second").binary == directories[2] / "only_second"
+  );
+  assert(index.find_by("not_found").binary.empty());
+  assert(index.find_by(".").binary.empty());
+  assert(index.find_by("..").binary.empty());
+  assert(index.find_by("").binary.empty());
+
+  //! the index is a snapshot
+  std::filesystem::remove(directories[0] / "shared");
+  assert(index.find_by("shared").binary == directories[0] / "shared");
+  assert(
+      cu0::ExecutableIndex::create(directories).find_by("shared").binary ==
+          directories[2] / "shared"
+  );
+
+  std::filesystem::remove_all(root);
+
+#if !defined(NOT_AN_X)
+  //! the same results as util::find_by()
+  const auto current = cu0::ExecutableIndex::create();
+  for (const auto& executable : { "ls", "sh", "not_an_executable_name", }) {
+    assert(
+        current.find_by(executable).binary ==
+            cu0::util::find_by(executable).binary
+    );
+  }
+#endif
+#else
+#warning <dirent.h> is not found => \
+cu0::ExecutableIndex will not be checked
+#endif
+
+  return 0;
+}
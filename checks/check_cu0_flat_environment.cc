@@ -0,0 +1,72 @@
+#include <cu0/env/flat_environment.hh>
+#include <cassert>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main() {
+  const auto to_strings = [](const cu0::FlatEnvironment& environment) {
+    auto ret = std::vector<std::string>{};
+    for (auto envp = environment.envp(); *envp != nullptr; envp++) {
+      ret.emplace_back(*envp);
+    }
+    assert(ret.size() == environment.size());
+    return ret;
+  };
+  {
+    const auto environment = cu0::FlatEnvironment{};
+    assert(environment.size() == 0);
+    assert(environment.envp()[0] == nullptr);
+    assert(!environment.find("key").has_value());
+  }
+  {
+    char key2[] = "key2=value2";
+    char key1[] = "key1=value1";
+    char duplicate[] = "key2=duplicate";
+    char* envp[] = { key2, key1, duplicate, nullptr, };
+    const auto environment =
+        cu0::FlatEnvironment::of(cu0::EnvironmentView::of(envp));
+    //! sorted by keys, the first value of a key is used
+    assert((
+        to_strings(environment) ==
+            std::vector<std::string>{ "key1=value1", "key2=value2", }
+    ));
+    assert(environment.find("key2").value() == "value2");
+    assert(!environment.find("key").has_value());
+  }
+  {
+    auto environment = cu0::FlatEnvironment::of(
+        std::map<std::string, std::string>{ { "b", "2", }, { "a", "1", }, }
+    );
+    assert(environment.find("a").value() == "1");
+    environment.set("c", "3");
+    environment.set("0", "0");
+    environment.set("b", "two");
+    environment.unset("a");
+    environment.unset("not_set");
+    assert((
+        to_strings(environment) ==
+            std::vector<std::string>{ "0=0", "b=two", "c=3", }
+    ));
+    //! replaced values are compacted
+    for (auto i = 0; i < 1000; i++) {
+      environment.set("b", std::to_string(i));
+    }
+    assert(environment.find("b").value() == "999");
+    assert(environment.view().size() == 3);
+
+    const auto copy = environment;
+    environment.set("b", "changed");
+    assert(copy.find("b").value() == "999");
+    assert(to_strings(copy).size() == 3);
+
+    //! short strings are moved with pointers fixed
+    auto moved = std::move(environment);
+    assert(moved.find("b").value() == "changed");
+    assert(to_strings(moved)[1] == "b=changed");
+    assert(environment.size() == 0);
+    assert(environment.envp()[0] == nullptr);
+  }
+  return 0;
+}
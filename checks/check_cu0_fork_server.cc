@@ -0,0 +1,148 @@
+#include <cu0/proc/fork_server.hh>
+#include <cassert>
+#include <iostream>
+#include <vector>
+#if __has_include(<sys/resource.h>)
+  #include <sys/resource.h> //! for a full file descriptor table
+#endif
+
+int main(int argc, char** argv) {
+  //! for subprocess check
+  if (argc > 1) {
+    if (std::string{argv[1]} == "echo") {
+      std::string input;
+      std::cin >> input;
+      std::cout << input;
+      std::cerr << input << input;
+      return 0;
+    }
+    return std::stoi(argv[1]);
+  }
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+  auto launched = cu0::ForkServer::launch();
+  assert(std::holds_alternative<cu0::ForkServer>(launched));
+  auto& fork_server = std::get<cu0::ForkServer>(launched);
+  assert(fork_server.pid() != 0);
+
+  {
+    auto created = fork_server.create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"echo"},
+    });
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    assert(process.pid() != 0);
+    assert(process.pid() != fork_server.pid());
+    assert(static_cast<bool>(process.stdin_pipe()));
+    assert(static_cast<bool>(process.stdout_pipe()));
+    assert(static_cast<bool>(process.stderr_pipe()));
+    process.stdin("input\n");
+    //! the created process is a child of this process => it can be waited
+    const auto wait_result = process.wait_cautious();
+    assert(std::holds_alternative<std::monostate>(wait_result));
+    assert(process.stdout() == "input");
+    assert(process.stderr() == "inputinput");
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 0);
+  }
+
+  {
+    auto created = fork_server.create_pipeless(cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"3"},
+    });
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    assert(process.pid() != 0);
+    assert(!static_cast<bool>(process.stdin_pipe()));
+    assert(!static_cast<bool>(process.stdout_pipe()));
+    assert(!static_cast<bool>(process.stderr_pipe()));
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 3);
+  }
+
+  {
+    auto created = fork_server.create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"4"},
+      .environment = { { "k1", "v1", }, { "k2", "v2", } },
+    });
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 4);
+  }
+
+  {
+    //! empty executable => exec fails in the created process
+    auto created = fork_server.create(cu0::Executable{});
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == ENOENT);
+  }
+
+#if __has_include(<sys/resource.h>)
+  {
+    //! no room for the pipes => the received pipes are closed and an error
+    //!     is reported instead of a process without pipes
+    auto limit = ::rlimit{};
+    assert(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    auto lowered = limit;
+    lowered.rlim_cur = 64;
+    assert(::setrlimit(RLIMIT_NOFILE, &lowered) == 0);
+    auto fillers = std::vector<int>{};
+    for (int fd; (fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC)) >= 0;) {
+      fillers.push_back(fd);
+    }
+    assert(!fillers.empty());
+    //! one descriptor fits => one of the three pipes is received
+    const auto free_fd = fillers.back();
+    ::close(free_fd);
+    fillers.pop_back();
+    auto created = fork_server.create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"0"},
+    });
+    assert(std::holds_alternative<cu0::Process::CreateError>(created));
+    assert(
+        std::get<cu0::Process::CreateError>(created) ==
+            cu0::Process::CreateError::MFILE
+    );
+    //! the received pipe is closed => its descriptor is free again
+    const auto reopened = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    assert(reopened == free_fd);
+    ::close(reopened);
+    for (const auto& fd : fillers) {
+      ::close(fd);
+    }
+    assert(::setrlimit(RLIMIT_NOFILE, &limit) == 0);
+  }
+#else
+#warning <sys/resource.h> is not found => \
+cu0::ForkServer::create() with a full file descriptor table will not be checked
+#endif
+
+  {
+    auto moved = cu0::ForkServer{std::move(fork_server)};
+    assert(moved.pid() != 0);
+    auto created = moved.create_pipeless(cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"0"},
+    });
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().value() == 0);
+  }
+#else
+#warning <sys/socket.h> or <sys/syscall.h> is not found => \
+cu0::ForkServer will not be checked
+#endif
+
+  return 0;
+}
@@ -2,8 +2,35 @@
 #include <cassert>
 #include <array>
 #include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <memory_resource>
+#include <new>
 #include <thread>
+#include <vector>
+#if __has_include(<sys/resource.h>)
+  #include <sys/resource.h> //! for a limit of file descriptors
+#endif
+
+//! number of allocations made by the global operator new
+//! @note allocations which bypass a memory resource are counted
+static auto allocations = std::atomic<std::size_t>{0};
+
+void* operator new(std::size_t size) {
+  allocations++;
+  if (auto* ret = std::malloc(size == 0 ? 1 : size); ret != nullptr) {
+    return ret;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
 
 int main(int argc, char** argv) {
 
@@ -166,6 +193,61 @@ cu0::Process::create_pipeless() will not be checked
   }
 
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
+  {
+    //! all the allocations of a spawn-and-capture cycle are made by
+    //!     the arena, the null upstream fails the others
+    auto buffer = std::array<std::byte, 1 << 16>{};
+    auto arena = std::pmr::monotonic_buffer_resource{
+      buffer.data(),
+      buffer.size(),
+      std::pmr::null_memory_resource(),
+    };
+    auto options = cu0::SpawnOptions{};
+    options.resource = &arena;
+    auto created = cu0::Process::create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = {"7"},
+          .environment = { { "key", "value", }, },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().value() == 7);
+    const auto out = process.stdout(&arena);
+    assert(out == "7");
+    assert(out.get_allocator().resource() == &arena);
+    const auto [error, err] = process.stderr_cautious(&arena);
+    assert(std::holds_alternative<std::monostate>(error));
+    assert(err == "77");
+    assert(err.get_allocator().resource() == &arena);
+  }
+  {
+    //! an overlay is serialized by the arena too
+    auto buffer = std::array<std::byte, 1 << 16>{};
+    auto arena = std::pmr::monotonic_buffer_resource{
+      buffer.data(),
+      buffer.size(),
+      std::pmr::null_memory_resource(),
+    };
+    auto options = cu0::SpawnOptions{};
+    options.resource = &arena;
+    options.environment = cu0::EnvironmentOverlay::current();
+    options.environment.value().set("key", "value");
+    const auto executable = cu0::Executable{
+      .binary = argv[0],
+      .arguments = {"7"},
+    };
+    const auto before = allocations.load();
+    auto created = cu0::Process::create(executable, options);
+    assert(allocations.load() == before);
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().value() == 7);
+  }
   {
     const auto executable_with_exit_code_two = cu0::Executable{
       .binary = argv[0],
@@ -267,6 +349,97 @@ cu0::Process::wait() will not be checked
 cu0::Process::wait_cautious() will not be checked
 #endif
 
+#if \
+    __has_include(<unistd.h>) && \
+    __has_include(<fcntl.h>) && \
+    __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+  {
+    assert(cu0::Process::create_many({}).empty());
+    const auto executables = std::array{
+      cu0::Executable{
+        .binary = argv[0],
+        .arguments = {"64"},
+        .environment = { { "k1", "v1", }, },
+      },
+      cu0::Executable{
+        .binary = argv[0],
+        .arguments = {"3"},
+        .environment = { { "k1", "v1", }, },
+      },
+      cu0::Executable{},
+      cu0::Executable{
+        .binary = argv[0],
+        .arguments = {"5"},
+      },
+    };
+    auto created = cu0::Process::create_many(executables);
+    assert(created.size() == executables.size());
+    for (auto& variant : created) {
+      assert(std::holds_alternative<cu0::Process>(variant));
+      auto& process = std::get<cu0::Process>(variant);
+      assert(process.pid() != 0);
+      assert(static_cast<bool>(process.stdin_pipe()));
+      assert(static_cast<bool>(process.stdout_pipe()));
+      assert(static_cast<bool>(process.stderr_pipe()));
+    }
+    auto& echo = std::get<cu0::Process>(created[0]);
+    echo.stdin("64\n");
+    echo.wait();
+    assert(echo.exit_code().value() == 64);
+    assert(echo.stdout() == "64");
+    assert(echo.stderr() == "6464");
+    auto& three = std::get<cu0::Process>(created[1]);
+    three.wait();
+    assert(three.exit_code().value() == 3);
+    assert(three.stdout() == "3");
+    assert(three.stderr() == "33");
+    //! empty executable => exec fails in the created process
+    auto& empty = std::get<cu0::Process>(created[2]);
+    empty.wait();
+    assert(empty.exit_code().value() == ENOENT);
+    auto& five = std::get<cu0::Process>(created[3]);
+    five.wait();
+    assert(five.exit_code().value() == 5);
+    assert(five.stdout() == "5");
+  }
+#if __has_include(<sys/resource.h>)
+  {
+    //! more processes than RLIMIT_NOFILE / 6 => the pipes of all the
+    //!     processes are not open at once
+    auto limit = ::rlimit{};
+    assert(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    auto lowered = limit;
+    lowered.rlim_cur = 256;
+    assert(::setrlimit(RLIMIT_NOFILE, &lowered) == 0);
+    const auto executables = std::vector<cu0::Executable>(
+        64,
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = {"7"},
+        }
+    );
+    auto created = cu0::Process::create_many(executables);
+    assert(created.size() == executables.size());
+    for (auto& variant : created) {
+      assert(std::holds_alternative<cu0::Process>(variant));
+      auto& process = std::get<cu0::Process>(variant);
+      process.wait();
+      assert(process.exit_code().value() == 7);
+    }
+    created.clear();
+    assert(::setrlimit(RLIMIT_NOFILE, &limit) == 0);
+  }
+#else
+#warning <sys/resource.h> is not found => \
+cu0::Process::create_many() under a limit of file descriptors will not be \
+checked
+#endif
+#else
+#warning <unistd.h> or <fcntl.h> or <sys/types.h> or <sys/wait.h> is not \
+found => cu0::Process::create_many() will not be checked
+#endif
+
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
   assert(!this_process.exit_code().has_value());
 #if __has_include(<unistd.h>)
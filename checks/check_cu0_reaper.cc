@@ -0,0 +1,148 @@
+#include <cu0/proc/reaper.hh>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#if __has_include(<sys/resource.h>)
+  #include <sys/resource.h> //! for a limit of file descriptors
+#endif
+
+int main(int argc, char** argv) {
+  //! for subprocess check
+  if (argc > 2 && std::string{argv[1]} == "sleep") {
+    std::this_thread::sleep_for(std::chrono::milliseconds{std::stoi(argv[2])});
+    return 0;
+  }
+  if (argc > 1) {
+    return std::stoi(argv[1]);
+  }
+
+#if \
+    __has_include(<poll.h>) && \
+    __has_include(<sys/eventfd.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+  auto& reaper = cu0::Reaper::instance();
+  assert(&reaper == &cu0::Reaper::instance());
+  assert(reaper.pending() == 0);
+
+  constexpr auto PROCESSES = 100;
+  auto exited = std::atomic<int>{0};
+  auto exit_codes = std::atomic<int>{0};
+  for (auto i = 0; i < PROCESSES; i++) {
+    const auto created = reaper.create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { std::to_string(i % 4), },
+        },
+        [&exited, &exit_codes](const cu0::Process& process){
+          assert(process.exit_code().has_value());
+          exit_codes += process.exit_code().value();
+          exited++;
+        }
+    );
+    assert(std::holds_alternative<unsigned>(created));
+    assert(std::get<unsigned>(created) != 0);
+  }
+  //! without a callback
+  assert(std::holds_alternative<unsigned>(reaper.create(cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"0"},
+  })));
+  //! empty executable => exec fails in the created process
+  auto exec_failed = std::atomic<int>{0};
+  assert(std::holds_alternative<unsigned>(reaper.create(
+      cu0::Executable{},
+      [&exec_failed](const cu0::Process& process){
+        exec_failed = process.exit_code().value();
+      }
+  )));
+  //! a process created elsewhere
+  auto created = cu0::Process::create(cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"7"},
+  });
+  assert(std::holds_alternative<cu0::Process>(created));
+  auto adopted_exit_code = std::atomic<int>{-1};
+  assert(std::holds_alternative<std::monostate>(reaper.adopt(
+      std::move(std::get<cu0::Process>(created)),
+      [&adopted_exit_code](const cu0::Process& process){
+        adopted_exit_code = process.exit_code().value();
+      }
+  )));
+
+  const auto start = std::chrono::steady_clock::now();
+  while (
+      reaper.pending() != 0 &&
+      std::chrono::steady_clock::now() - start < std::chrono::seconds{32}
+  ) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  assert(reaper.pending() == 0);
+  assert(exited == PROCESSES);
+  assert(exit_codes == PROCESSES / 4 * (0 + 1 + 2 + 3));
+  assert(exec_failed == ENOENT);
+  assert(adopted_exit_code == 7);
+  //! no zombies are left
+  assert(::waitpid(-1, nullptr, WNOHANG) == -1);
+  assert(errno == ECHILD);
+
+  //! a waited process can not be adopted
+  auto waited = cu0::Process::create_pipeless(cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"0"},
+  });
+  auto& waited_process = std::get<cu0::Process>(waited);
+  waited_process.wait();
+  const auto not_adopted = reaper.adopt(std::move(waited_process));
+  assert(std::holds_alternative<cu0::Reaper::AdoptError>(not_adopted));
+  assert(
+      std::get<cu0::Reaper::AdoptError>(not_adopted) ==
+          cu0::Reaper::AdoptError::SRCH
+  );
+  //! not moved
+  assert(waited_process.pid() != 0);
+
+#if __has_include(<sys/resource.h>)
+  {
+    //! more pidfds than RLIMIT_NOFILE => the pidfds can not be polled and
+    //!     the processes are still waited
+    constexpr auto SLEEPING = 4;
+    for (auto i = 0; i < SLEEPING; i++) {
+      assert(std::holds_alternative<unsigned>(reaper.create(cu0::Executable{
+        .binary = argv[0],
+        .arguments = { "sleep", "200", },
+      })));
+    }
+    auto limit = ::rlimit{};
+    assert(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    auto lowered = limit;
+    lowered.rlim_cur = SLEEPING;
+    assert(::setrlimit(RLIMIT_NOFILE, &lowered) == 0);
+    const auto lowered_at = std::chrono::steady_clock::now();
+    while (
+        reaper.pending() != 0 &&
+        std::chrono::steady_clock::now() - lowered_at < std::chrono::seconds{8}
+    ) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    assert(::setrlimit(RLIMIT_NOFILE, &limit) == 0);
+    assert(reaper.pending() == 0);
+    assert(::waitpid(-1, nullptr, WNOHANG) == -1);
+    assert(errno == ECHILD);
+  }
+#else
+#warning <sys/resource.h> is not found => cu0::Reaper under a limit of file \
+descriptors will not be checked
+#endif
+#else
+  (void)argc;
+  (void)argv;
+#warning <poll.h> or <sys/eventfd.h> or <sys/syscall.h> or <sys/types.h> or \
+<sys/wait.h> is not found => cu0::Reaper will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,342 @@
+#include <cu0/proc/process.hh>
+#include <cu0/proc/spawn_options.hh>
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+int main(int argc, char** argv) {
+  //! for subprocess check
+  if (argc > 1) {
+    const auto mode = std::string{argv[1]};
+#if __has_include(<sched.h>)
+    if (mode == "affinity") {
+      auto set = cpu_set_t{};
+      CPU_ZERO(&set);
+      if (::sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return 255;
+      }
+      return CPU_COUNT(&set);
+    }
+    if (mode == "policy") {
+      return ::sched_getscheduler(0);
+    }
+#endif
+#if __has_include(<sys/resource.h>)
+    if (mode == "nice") {
+      return ::getpriority(PRIO_PROCESS, 0);
+    }
+    if (mode == "limits") {
+      //! returns a bit per expected limit
+      auto limit = rlimit{};
+      auto ret = 0;
+      if (
+          ::getrlimit(RLIMIT_AS, &limit) == 0 &&
+          limit.rlim_cur == rlim_t{1} << 32
+      ) {
+        ret |= 1;
+      }
+      if (
+          ::getrlimit(RLIMIT_CPU, &limit) == 0 &&
+          limit.rlim_cur == 60 &&
+          limit.rlim_max == 120
+      ) {
+        ret |= 2;
+      }
+      if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur == 64) {
+        ret |= 4;
+      }
+      return ret;
+    }
+#endif
+#if __has_include(<fcntl.h>)
+    if (mode == "descriptors" && argc > 2) {
+      //! returns a bit per unexpected state
+      auto ret = 0;
+      if (::write(21, "p", 1) != 1) {
+        ret |= 1;
+      }
+      if (::write(20, "q", 1) != 1) {
+        ret |= 2;
+      }
+      //! the file descriptor which has not been specified
+      if (::fcntl(std::stoi(argv[2]), F_GETFD) >= 0) {
+        ret |= 4;
+      }
+      return ret;
+    }
+    if (mode == "inherited") {
+      //! returns a bit per unexpected state
+      auto ret = 0;
+      if (::write(21, "p", 1) != 1) {
+        ret |= 1;
+      }
+      //! the file descriptor above the specified ones is inherited as is
+      if (::write(22, "r", 1) != 1) {
+        ret |= 2;
+      }
+      return ret;
+    }
+#endif
+#if __has_include(<sys/syscall.h>)
+    if (mode == "io_priority") {
+      //! IOPRIO_WHO_PROCESS == 1
+      return static_cast<int>(::syscall(SYS_ioprio_get, 1, 0));
+    }
+#endif
+    if (mode == "environment") {
+      //! returns a bit per unexpected state
+      auto ret = 0;
+      const auto* set = std::getenv("CU0_CHECK_SET");
+      if (set == NULL || std::string{set} != "value") {
+        ret |= 1;
+      }
+      if (std::getenv("CU0_CHECK_UNSET") != NULL) {
+        ret |= 2;
+      }
+      const auto* kept = std::getenv("CU0_CHECK_KEPT");
+      if (kept == NULL || std::string{kept} != "kept") {
+        ret |= 4;
+      }
+      return ret;
+    }
+    return 0;
+  }
+
+#if __has_include(<unistd.h>) && __has_include(<sys/wait.h>)
+  const auto exit_code = [argv](
+      const std::string& mode,
+      const cu0::SpawnOptions& options
+  ) {
+    auto created = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { mode, },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().has_value());
+    return process.exit_code().value();
+  };
+
+#if __has_include(<sched.h>)
+  {
+    //! empty options => attributes are inherited
+    assert(exit_code("policy", {}) == ::sched_getscheduler(0));
+  }
+  {
+    auto options = cu0::SpawnOptions{};
+    options.affinity = cpu_set_t{};
+    CPU_ZERO(&options.affinity.value());
+    CPU_SET(0, &options.affinity.value());
+    assert(exit_code("affinity", options) == 1);
+  }
+  {
+    auto options = cu0::SpawnOptions{};
+    options.policy = cu0::SpawnOptions::Policy::BATCH;
+    assert(exit_code("policy", options) == SCHED_BATCH);
+    options.policy = cu0::SpawnOptions::Policy::IDLE;
+    assert(exit_code("policy", options) == SCHED_IDLE);
+  }
+  {
+    //! options can not be applied => the process does not run
+    auto options = cu0::SpawnOptions{};
+    options.affinity = cpu_set_t{};
+    CPU_ZERO(&options.affinity.value());
+    auto created = cu0::Process::create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = {"affinity"},
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process::CreateError>(created));
+    assert(
+        std::get<cu0::Process::CreateError>(created) ==
+            cu0::Process::CreateError::INVAL
+    );
+  }
+#else
+#warning <sched.h> is not found => \
+cu0::SpawnOptions::affinity and cu0::SpawnOptions::policy will not be checked
+#endif
+
+#if __has_include(<sys/resource.h>)
+  {
+    //! empty options => attributes are inherited
+    assert(exit_code("nice", {}) == ::getpriority(PRIO_PROCESS, 0));
+  }
+  {
+    auto options = cu0::SpawnOptions{};
+    options.nice = 19;
+    assert(exit_code("nice", options) == 19);
+  }
+  {
+    auto limit = rlimit{};
+    assert(::getrlimit(RLIMIT_AS, &limit) == 0);
+    auto options = cu0::SpawnOptions{};
+    options.address_space = rlimit{
+      .rlim_cur = rlim_t{1} << 32,
+      .rlim_max = limit.rlim_max,
+    };
+    options.cpu_time = rlimit{ .rlim_cur = 60, .rlim_max = 120, };
+    assert(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    options.open_files = rlimit{ .rlim_cur = 64, .rlim_max = limit.rlim_max, };
+    assert(exit_code("limits", options) == (1 | 2 | 4));
+    //! the limits of this process are not changed
+    assert(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    assert(limit.rlim_cur != 64);
+  }
+#else
+#warning <sys/resource.h> is not found => \
+cu0::SpawnOptions::nice and limits will not be checked
+#endif
+
+#if __has_include(<fcntl.h>)
+  for (const auto close_others : { true, false, }) {
+    int p[2];
+    int q[2];
+    assert(::pipe(p) == 0);
+    assert(::pipe(q) == 0);
+    assert(::dup2(p[1], 20) == 20);
+    assert(::dup2(q[1], 21) == 21);
+    ::close(p[1]);
+    ::close(q[1]);
+    //! the file descriptors are swapped in the process
+    auto options = cu0::SpawnOptions{};
+    options.descriptors = { { 20, 21, }, { 21, 20, }, };
+    options.close_others = close_others;
+    auto created = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "descriptors", std::to_string(p[0]), },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == (close_others ? 0 : 4));
+    ::close(20);
+    ::close(21);
+    char buffer[2] = {};
+    assert(::read(p[0], buffer, sizeof(buffer)) == 1);
+    assert(buffer[0] == 'p');
+    assert(::read(q[0], buffer, sizeof(buffer)) == 1);
+    assert(buffer[0] == 'q');
+    ::close(p[0]);
+    ::close(q[0]);
+  }
+  {
+    //! a file descriptor without FD_CLOEXEC above the specified ones is not
+    //!     overwritten when the descriptors are duplicated
+    int p[2];
+    int r[2];
+    assert(::pipe(p) == 0);
+    assert(::pipe(r) == 0);
+    assert(::dup2(p[1], 20) == 20);
+    assert(::dup2(r[1], 22) == 22);
+    ::close(p[1]);
+    ::close(r[1]);
+    auto options = cu0::SpawnOptions{};
+    options.descriptors = { { 20, 21, }, };
+    auto created = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "inherited", },
+        },
+        options
+    );
+    assert(std::holds_alternative<cu0::Process>(created));
+    auto& process = std::get<cu0::Process>(created);
+    process.wait();
+    assert(process.exit_code().has_value());
+    assert(process.exit_code().value() == 0);
+    ::close(20);
+    ::close(22);
+    char buffer[2] = {};
+    assert(::read(p[0], buffer, sizeof(buffer)) == 1);
+    assert(buffer[0] == 'p');
+    assert(::read(r[0], buffer, sizeof(buffer)) == 1);
+    assert(buffer[0] == 'r');
+    ::close(p[0]);
+    ::close(r[0]);
+  }
+  {
+    //! invalid file descriptor => the process does not run
+    auto options = cu0::SpawnOptions{};
+    options.descriptors = { { 1000, 3, }, };
+    const auto created = cu0::Process::create(cu0::Executable{}, options);
+    assert(std::holds_alternative<cu0::Process::CreateError>(created));
+  }
+#else
+#warning <fcntl.h> is not found => \
+cu0::SpawnOptions::descriptors will not be checked
+#endif
+
+#if __has_include(<sys/syscall.h>)
+  {
+    auto options = cu0::SpawnOptions{};
+    options.io_priority = cu0::SpawnOptions::IoPriority{
+      .io_class = cu0::SpawnOptions::IoClass::BEST_EFFORT,
+      .level = 7,
+    };
+    //! IOPRIO_CLASS_SHIFT == 13
+    assert(exit_code("io_priority", options) == (2 << 13 | 7) % 256);
+    options.io_priority = cu0::SpawnOptions::IoPriority{
+      .io_class = cu0::SpawnOptions::IoClass::IDLE,
+    };
+    assert(exit_code("io_priority", options) == (3 << 13) % 256);
+  }
+#else
+#warning <sys/syscall.h> is not found => \
+cu0::SpawnOptions::io_priority will not be checked
+#endif
+#if !defined(NOT_AN_X)
+  {
+    ::setenv("CU0_CHECK_UNSET", "value", true);
+    ::setenv("CU0_CHECK_KEPT", "kept", true);
+    auto options = cu0::SpawnOptions{};
+    options.environment = cu0::EnvironmentOverlay::current();
+    options.environment.value()
+        .set("CU0_CHECK_SET", "value")
+        .unset("CU0_CHECK_UNSET");
+    assert(exit_code("environment", options) == 0);
+    //! the environment of this process is not modified
+    assert(std::getenv("CU0_CHECK_SET") == NULL);
+    assert(std::getenv("CU0_CHECK_UNSET") != NULL);
+    ::unsetenv("CU0_CHECK_UNSET");
+    ::unsetenv("CU0_CHECK_KEPT");
+  }
+  {
+    auto options = cu0::SpawnOptions{};
+    options.environment_block = cu0::EnvironmentBlock::of(
+        std::map<std::string, std::string>{
+          { "CU0_CHECK_KEPT", "kept", },
+          { "CU0_CHECK_SET", "value", },
+        }
+    );
+    //! the block is used instead of the overlay
+    options.environment = cu0::EnvironmentOverlay::current();
+    options.environment.value().set("CU0_CHECK_UNSET", "value");
+    //! the block is shared by the processes
+    const auto copy = options;
+    assert(exit_code("environment", options) == 0);
+    assert(exit_code("environment", copy) == 0);
+    assert(
+        copy.environment_block.value().envp() ==
+            options.environment_block.value().envp()
+    );
+  }
+#endif
+#else
+#warning <unistd.h> or <sys/wait.h> is not found => \
+cu0::SpawnOptions will not be checked
+#endif
+
+  return 0;
+}
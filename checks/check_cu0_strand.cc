@@ -1,11 +1,15 @@
 #include <cu0/proc/strand.hh>
 #include <atomic> //! for storing task execution result
 #include <cassert>
+#include <memory> //! for a move-only task
 #include <thread> //! for a sleep inside a strand
 #include <chrono> //! for specifying a sleep duration
 #if __has_include(<pthread.h>)
   #include <pthread.h> //! for validating priority, policy, and stack size
 #endif
+#if __has_include(<sched.h>)
+  #include <sched.h> //! for validating cpu affinity
+#endif
 #if __has_include(<unistd.h>)
   #include <unistd.h> //! for validating stack size
 #endif
@@ -31,7 +35,7 @@ int main() {
     const auto task = [&atomic]() { atomic = true; };
     auto strand_create_variant = cu0::Strand::create(task);
     assert(std::holds_alternative<cu0::Strand>(strand_create_variant));
-    auto strand_task = std::get<cu0::Strand>(strand_create_variant);
+    auto& strand_task = std::get<cu0::Strand>(strand_create_variant);
     assert(atomic == false);
     const auto run_result = strand_task.run();
     assert(std::holds_alternative<std::monostate>(run_result));
@@ -40,6 +44,22 @@ int main() {
     assert(atomic == true);
   }
 
+  //! check create function with a move-only task
+  {
+    auto value = std::make_unique<int>(4);
+    auto result = std::atomic<int>{0};
+    auto strand_create_variant = cu0::Strand::create(
+        [value = std::move(value), &result]() { result = *value; }
+    );
+    assert(std::holds_alternative<cu0::Strand>(strand_create_variant));
+    auto& strand_task = std::get<cu0::Strand>(strand_create_variant);
+    const auto run_result = strand_task.run();
+    assert(std::holds_alternative<std::monostate>(run_result));
+    const auto join_result = strand_task.join();
+    assert(std::holds_alternative<std::monostate>(join_result));
+    assert(result == 4);
+  }
+
   auto stop = std::atomic<bool>(false);
   auto strand_create_variant = cu0::Strand::create([&stop]() {
     while (!stop) {
@@ -521,11 +541,104 @@ const std::size_t) will not be checked
 #warning <stdlib.h> or <unistd.h> is not found => \
 cu0::Strand::deallocate_stack<cu0::Strand::Stage::TERMINATED>() \
 will not be checked
+#endif
+
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+  {
+    //! the cpus of the process may exclude cpu 0, e.g. in a container
+    auto allowed = cpu_set_t{};
+    CPU_ZERO(&allowed);
+    assert(::sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0);
+    auto cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+      cpu++;
+    }
+    auto pinned = cpu_set_t{};
+    CPU_ZERO(&pinned);
+    CPU_SET(cpu, &pinned);
+
+    auto release = std::atomic<bool>{false};
+    auto running_cpu = std::atomic<int>{-1};
+    auto strand_for_affinity_create_variant =
+        cu0::Strand::create([&release, &running_cpu](){
+          running_cpu = ::sched_getcpu();
+          while (!release) {
+            std::this_thread::yield();
+          }
+        });
+    assert(std::holds_alternative<cu0::Strand>(
+        strand_for_affinity_create_variant
+    ));
+
+    auto& strand_for_affinity =
+        std::get<cu0::Strand>(strand_for_affinity_create_variant);
+
+    {
+      const auto set_affinity_variant =
+          strand_for_affinity.affinity<cu0::Strand::Stage::NOT_LAUNCHED>(
+              pinned
+          );
+      assert(std::holds_alternative<std::monostate>(set_affinity_variant));
+    }
+    {
+      const auto get_affinity_variant =
+          strand_for_affinity.affinity<cu0::Strand::Stage::NOT_LAUNCHED>();
+      assert(std::holds_alternative<cpu_set_t>(get_affinity_variant));
+      const auto& affinity = std::get<cpu_set_t>(get_affinity_variant);
+      assert(CPU_EQUAL(&affinity, &pinned));
+    }
+    {
+      const auto run_variant = strand_for_affinity.run();
+      assert(std::holds_alternative<std::monostate>(run_variant));
+    }
+    while (running_cpu == -1) {
+      std::this_thread::yield();
+    }
+    assert(running_cpu == cpu);
+    {
+      const auto get_affinity_variant =
+          strand_for_affinity.affinity<cu0::Strand::Stage::LAUNCHED>();
+      assert(std::holds_alternative<cpu_set_t>(get_affinity_variant));
+      const auto& affinity = std::get<cpu_set_t>(get_affinity_variant);
+      assert(CPU_EQUAL(&affinity, &pinned));
+    }
+    {
+      const auto set_affinity_variant =
+          strand_for_affinity.affinity<cu0::Strand::Stage::LAUNCHED>(allowed);
+      assert(std::holds_alternative<std::monostate>(set_affinity_variant));
+    }
+    {
+      const auto get_affinity_variant =
+          strand_for_affinity.affinity<cu0::Strand::Stage::LAUNCHED>();
+      assert(std::holds_alternative<cpu_set_t>(get_affinity_variant));
+      const auto& affinity = std::get<cpu_set_t>(get_affinity_variant);
+      assert(CPU_EQUAL(&affinity, &allowed));
+    }
+    {
+      //! a set without cpus is not allowed
+      auto empty = cpu_set_t{};
+      CPU_ZERO(&empty);
+      const auto set_affinity_variant =
+          strand_for_affinity.affinity<cu0::Strand::Stage::LAUNCHED>(empty);
+      assert(std::holds_alternative<cu0::Strand::SetAffinityError>(
+          set_affinity_variant
+      ));
+    }
+    release = true;
+    const auto join_variant = strand_for_affinity.join();
+    assert(std::holds_alternative<std::monostate>(join_variant));
+  }
+#else
+#warning <pthread.h> or <sched.h> is not found => \
+cu0::Strand::affinity<cu0::Strand::Stage::NOT_LAUNCHED>() will not be checked
+#warning <pthread.h> or <sched.h> is not found => \
+cu0::Strand::affinity<cu0::Strand::Stage::LAUNCHED>() will not be checked
 #endif
 
   {
+    auto finished = std::atomic<bool>{false};
     auto strand_for_detach_create_variant =
-        cu0::Strand::create([](){ return; });
+        cu0::Strand::create([&finished](){ finished = true; });
     assert(std::holds_alternative<cu0::Strand>(
         strand_for_detach_create_variant
     ));
@@ -545,6 +658,11 @@ will not be checked
       assert(std::holds_alternative<std::monostate>(detach_variant));
     }
     //! repeat of detach will result in unspecified behaviour
+
+    //! the task is stored by the strand => the strand needs to outlive it
+    while (!finished) {
+      std::this_thread::yield();
+    }
   }
 
   //! check join function
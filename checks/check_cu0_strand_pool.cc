@@ -0,0 +1,172 @@
+#include <cu0/proc/strand_pool.hh>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <variant>
+#if __has_include(<pthread.h>)
+  #include <pthread.h> //! for validating stack size
+#endif
+#if __has_include(<sched.h>)
+  #include <sched.h> //! for validating cpu affinity
+#endif
+
+int main() {
+#if \
+    __has_include(<pthread.h>) && \
+    __has_include(<sched.h>) && \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<stdlib.h>) && \
+    __has_include(<unistd.h>)
+  {
+    //! the submitted tasks are executed before the pool is destructed
+    auto executed = std::atomic<int>{0};
+    {
+      auto create_variant = cu0::StrandPool::create({ .size = 4, });
+      assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+      auto& pool = std::get<cu0::StrandPool>(create_variant);
+      assert(pool.size() == 4);
+      for (auto i = 0; i < 10000; i++) {
+        pool.submit([&executed]() { executed++; });
+      }
+    }
+    assert(executed == 10000);
+  }
+  {
+    //! tasks submitted by tasks are pushed to the deques of the strands and
+    //!     stolen by other strands
+    auto executed = std::atomic<int>{0};
+    {
+      auto create_variant = cu0::StrandPool::create({ .size = 4, });
+      assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+      auto& pool = std::get<cu0::StrandPool>(create_variant);
+      for (auto i = 0; i < 16; i++) {
+        pool.submit([&pool, &executed]() {
+          for (auto j = 0; j < 1000; j++) {
+            pool.submit([&executed]() { executed++; });
+          }
+        });
+      }
+    }
+    assert(executed == 16 * 1000);
+  }
+  {
+    //! the pool is waited on until the tasks are executed
+    auto executed = std::atomic<int>{0};
+    auto create_variant = cu0::StrandPool::create({ .size = 2, });
+    assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+    auto& pool = std::get<cu0::StrandPool>(create_variant);
+    for (auto i = 0; i < 100; i++) {
+      pool.submit([&executed]() { executed++; });
+    }
+    while (executed != 100) {
+      std::this_thread::yield();
+    }
+    //! the strands wait for tasks and are woken by a submission
+    std::this_thread::sleep_for(std::chrono::milliseconds{16});
+    pool.submit([&executed]() { executed++; });
+    while (executed != 101) {
+      std::this_thread::yield();
+    }
+  }
+  {
+    //! a move-only task is executed
+    auto value = std::make_unique<int>(16);
+    auto result = std::atomic<int>{0};
+    {
+      auto create_variant = cu0::StrandPool::create({ .size = 1, });
+      assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+      auto& pool = std::get<cu0::StrandPool>(create_variant);
+      pool.submit([value = std::move(value), &result]() { result = *value; });
+    }
+    assert(result == 16);
+  }
+  {
+    //! the strands are created with the specified scheduling and stack size
+    const auto page_size = sysconf(_SC_PAGE_SIZE);
+    assert(page_size > 0);
+    const auto stack_size = static_cast<
+        unsigned long
+    >(PTHREAD_STACK_MIN / page_size + 4) * page_size;
+    auto executed = std::atomic<int>{0};
+    {
+      auto create_variant = cu0::StrandPool::create({
+        .size = 2,
+        .scheduling = cu0::Strand::Scheduling{
+          //! permissions may not be enough for other policies
+          .policy = cu0::Strand::Policy::PTHREAD_OTHER,
+          .priority = sched_get_priority_min(
+              static_cast<int>(cu0::Strand::Policy::PTHREAD_OTHER)
+          ),
+        },
+        .stack_size = stack_size,
+      });
+      assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+      auto& pool = std::get<cu0::StrandPool>(create_variant);
+      for (auto i = 0; i < 100; i++) {
+        pool.submit([&executed]() { executed++; });
+      }
+      //! a pool is movable
+      auto moved = std::move(pool);
+      moved.submit([&executed]() { executed++; });
+    }
+    assert(executed == 101);
+  }
+  {
+    //! an invalid policy is reported and the launched strands are joined
+    const auto create_variant = cu0::StrandPool::create({
+      .size = 2,
+      .scheduling = cu0::Strand::Scheduling{
+        .policy = static_cast<cu0::Strand::Policy>(-1),
+      },
+    });
+    assert(std::holds_alternative<cu0::Strand::SetPolicyError>(create_variant));
+  }
+  {
+    //! the strands are pinned to the specified cpus
+    auto allowed = cpu_set_t{};
+    CPU_ZERO(&allowed);
+    assert(::sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0);
+    auto cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+      cpu++;
+    }
+    auto pinned = cpu_set_t{};
+    CPU_ZERO(&pinned);
+    CPU_SET(cpu, &pinned);
+    auto elsewhere = std::atomic<int>{0};
+    {
+      auto create_variant = cu0::StrandPool::create({
+        .size = 2,
+        .affinities = { pinned, },
+      });
+      assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+      auto& pool = std::get<cu0::StrandPool>(create_variant);
+      for (auto i = 0; i < 100; i++) {
+        pool.submit([&elsewhere, &cpu]() {
+          if (::sched_getcpu() != cpu) {
+            elsewhere++;
+          }
+        });
+      }
+    }
+    assert(elsewhere == 0);
+  }
+  {
+    //! the default size is the number of online processors
+    auto create_variant = cu0::StrandPool::create({});
+    assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+    const auto& pool = std::get<cu0::StrandPool>(create_variant);
+    assert(pool.size() == static_cast<std::size_t>(
+        sysconf(_SC_NPROCESSORS_ONLN)
+    ));
+  }
+#else
+#warning <pthread.h>, <sched.h>, <linux/futex.h>, <sys/syscall.h>, \
+<stdlib.h> or <unistd.h> is not found => cu0::StrandPool will not be checked
+#endif
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+#include <cu0/proc/task.hh>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <utility>
+
+int main() {
+  //! counts constructions and destructions of the callables
+  struct Counter {
+    int* alive;
+    int* calls;
+    Counter(int* alive, int* calls) : alive{alive}, calls{calls} {
+      (*this->alive)++;
+    }
+    Counter(const Counter& other) : alive{other.alive}, calls{other.calls} {
+      (*this->alive)++;
+    }
+    Counter(Counter&& other) noexcept
+        : alive{other.alive}, calls{other.calls} {
+      (*this->alive)++;
+    }
+    ~Counter() {
+      (*this->alive)--;
+    }
+    void operator ()() {
+      (*this->calls)++;
+    }
+  };
+  //! a callable which does not fit into the buffer
+  struct Large : public Counter {
+    using Counter::Counter;
+    std::array<char, 128> payload{};
+  };
+
+  static_assert(cu0::Task<>::stored_inline<Counter>());
+  static_assert(cu0::Task<>::stored_inline<std::function<void()>>());
+  static_assert(!cu0::Task<>::stored_inline<Large>());
+  static_assert(cu0::Task<256>::stored_inline<Large>());
+  static_assert(!std::is_copy_constructible_v<cu0::Task<>>);
+  static_assert(std::is_nothrow_move_constructible_v<cu0::Task<>>);
+
+  {
+    auto task = cu0::Task<>{};
+    assert(!task);
+  }
+  {
+    auto value = 0;
+    auto task = cu0::Task<>{[&value]() { value++; }};
+    assert(task);
+    task();
+    task();
+    assert(value == 2);
+  }
+  {
+    //! a move-only callable is stored
+    auto value = std::make_unique<int>(8);
+    auto result = 0;
+    auto task = cu0::Task<>{
+      [value = std::move(value), &result]() { result = *value; },
+    };
+    task();
+    assert(result == 8);
+  }
+  {
+    auto alive = 0;
+    auto calls = 0;
+    {
+      auto task = cu0::Task<>{Counter{&alive, &calls}};
+      assert(alive == 1);
+      auto moved = std::move(task);
+      assert(!task);
+      assert(moved);
+      assert(alive == 1);
+      moved();
+      assert(calls == 1);
+      auto assigned = cu0::Task<>{};
+      assigned = std::move(moved);
+      assert(!moved);
+      assert(alive == 1);
+      assigned();
+      assert(calls == 2);
+      assigned = cu0::Task<>{Counter{&alive, &calls}};
+      assert(alive == 1);
+    }
+    assert(alive == 0);
+  }
+  {
+    auto alive = 0;
+    auto calls = 0;
+    {
+      auto task = cu0::Task<>{Large{&alive, &calls}};
+      assert(alive == 1);
+      //! the callable on the heap is not moved
+      auto moved = std::move(task);
+      assert(alive == 1);
+      moved();
+      assert(calls == 1);
+    }
+    assert(alive == 0);
+  }
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <cu0/proc/cgroup.hh>
+#include <cu0/proc/process.hh>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if \
+    !__has_include(<fcntl.h>) || \
+    !__has_include(<sys/stat.h>) || \
+    !__has_include(<unistd.h>)
+#warning <fcntl.h> or <sys/stat.h> or <unistd.h> is not found => \
+cu0::Cgroup will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  const auto current = cu0::Cgroup::current();
+  if (!current.has_value()) {
+    std::cout << "Error: cgroup v2 hierarchy is not mounted" << '\n';
+    return 1;
+  }
+  auto created = cu0::Cgroup::create(current.value() / "some_cgroup");
+  if (!std::holds_alternative<cu0::Cgroup>(created)) {
+    std::cout << "Error: the cgroup was not created" << '\n';
+    return 2;
+  }
+  const auto& cgroup = std::get<cu0::Cgroup>(created);
+  //! @note memory and cpu controllers need to be enabled in the parent cgroup
+  if (
+      !std::holds_alternative<std::monostate>(
+          cgroup.memory_max(std::uint64_t{1} << 30)
+      ) ||
+      !std::holds_alternative<std::monostate>(
+          cgroup.cpu_max(std::chrono::milliseconds{50})
+      )
+  ) {
+    std::cout << "Error: the limits were not set" << '\n';
+    return 3;
+  }
+  //! @note the process is placed into the cgroup before it runs the executable
+  auto options = cu0::SpawnOptions{};
+  options.cgroup = cgroup.fd();
+  options.open_files = rlimit{ .rlim_cur = 1024, .rlim_max = 1024, };
+  auto variant = cu0::Process::create_pipeless(
+      cu0::Executable{
+        .binary = "some_executable"
+      },
+      options
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 4;
+  }
+  //! @note the cgroup is removed when it is destructed if it is empty =>
+  //!     wait for the process before
+  std::get<cu0::Process>(variant).wait();
+}
+
+#endif
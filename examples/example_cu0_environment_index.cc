@@ -0,0 +1,16 @@
+#include <cu0/env/environment_index.hh>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the index is built on the first call and
+  //!     rebuilt after cu0::EnvironmentVariable::set() or unset()
+  const auto& index = cu0::EnvironmentIndex::current();
+  for (const auto& key : { "HOME", "PATH", "SHELL", }) {
+    //! @note a lookup takes constant time and does not allocate
+    const auto value = index.find(key);
+    if (value.has_value()) {
+      std::cout << key << "=" << value.value() << '\n';
+    }
+  }
+}
@@ -0,0 +1,28 @@
+#include <cu0/env/environment_keys.hh>
+#include <array>
+#include <iostream>
+#include <string_view>
+
+//! @note the keys used by the application are declared at compile time
+static constexpr auto KEYS = std::to_array<std::string_view>({
+  "HOME",
+  "SOME_LOG_LEVEL",
+  "SOME_TIMEOUT",
+});
+using Keys = cu0::EnvironmentKeys<KEYS>;
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the environment is read once for all the keys
+  const auto keys = Keys::synced();
+  //! @note the index of a key is computed at compile time =>
+  //!     a lookup is an array access
+  constexpr auto LOG_LEVEL = Keys::index_of("SOME_LOG_LEVEL").value();
+  const auto& log_level = keys.at(LOG_LEVEL).cached();
+  std::cout << "SOME_LOG_LEVEL=" << log_level.value_or("<not-set>") << '\n';
+  //! @note a key known at run time is found by one hash and one comparison
+  const auto* home = keys.find("HOME");
+  if (home != nullptr && home->cached().has_value()) {
+    std::cout << "HOME=" << home->cached().value() << '\n';
+  }
+}
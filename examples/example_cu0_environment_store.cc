@@ -0,0 +1,42 @@
+#include <cu0/env/environment_store.hh>
+#include <iostream>
+#include <thread>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+cu0::EnvironmentStore will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the store is a copy of the environment made on the first access
+  auto& store = cu0::EnvironmentStore::instance();
+  auto reader = std::thread{[&store] {
+    //! @note a reader is registered for the replaced snapshots
+    //!     not to be freed while it uses them
+    auto registered = cu0::EnvironmentStore::Reader{store};
+    //! @note a reader does not lock and
+    //!     the loaded snapshot does not change
+    const auto& snapshot = registered.load();
+    const auto level = snapshot.find("SOME_LOG_LEVEL");
+    std::cout << "SOME_LOG_LEVEL=" << level.value_or("unset") << '\n';
+    //! @note the snapshot is not used anymore => it may be freed
+    registered.quiescent();
+  }};
+  //! @note a writer publishes a new snapshot
+  if (!std::holds_alternative<std::monostate>(
+      store.set("SOME_LOG_LEVEL", "debug")
+  )) {
+    std::cout << "Error: the value was not set" << '\n';
+  }
+  reader.join();
+}
+
+#endif
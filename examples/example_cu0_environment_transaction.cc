@@ -0,0 +1,34 @@
+#include <cu0/env/environment_transaction.hh>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+cu0::EnvironmentTransaction will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the modifications are collected without modifying the environment
+  auto transaction = cu0::EnvironmentTransaction::begin();
+  for (auto i = 0; i < 32; i++) {
+    transaction.set("SOME_WORKER_" + std::to_string(i), std::to_string(i));
+  }
+  transaction.unset("SOME_SECRET");
+  //! @note the environment is rebuilt once for all the modifications
+  if (!std::holds_alternative<std::monostate>(transaction.commit())) {
+    std::cout << "Error: the environment was not modified" << '\n';
+    return 1;
+  }
+  std::cout << "SOME_WORKER_31=" << std::getenv("SOME_WORKER_31") << '\n';
+}
+
+#endif
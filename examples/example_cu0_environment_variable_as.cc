@@ -0,0 +1,21 @@
+#include <cu0/env/environment_variable.hh>
+#include <chrono>
+#include <iostream>
+
+int main() {
+  //! @note environment variables may not be set
+  const auto timeout = cu0::EnvironmentVariable::synced("SOME_TIMEOUT");
+  const auto path = cu0::EnvironmentVariable::synced("PATH");
+  for (auto i = 0; i < 3; i++) {
+    //! @note the value is parsed on the first call only =>
+    //!     the next calls do not parse until the value changes
+    //! @note a value like "1500ms" or "2s" is accepted
+    const auto parsed = timeout.as<std::chrono::milliseconds>();
+    std::cout << "SOME_TIMEOUT in milliseconds: " <<
+        (parsed.has_value() ? parsed.value().count() : -1) << '\n';
+  }
+  //! @note the parts are cached as well
+  for (const auto& directory : path.split(':')) {
+    std::cout << "PATH directory: " << directory << '\n';
+  }
+}
@@ -0,0 +1,20 @@
+#include <cu0/env/environment_variable.hh>
+#include <iostream>
+
+int main() {
+  //! @note environment variable may not be set
+  auto log_level = cu0::EnvironmentVariable::synced("SOME_LOG_LEVEL");
+  for (auto i = 0; i < 1000; i++) {
+    //! @note if nothing has been modified by cu0::EnvironmentVariable::set()
+    //!     or unset() => one atomic load without reading the environment
+    if (log_level.is_stale()) {
+      log_level.sync();
+    }
+    if (i == 500) {
+      //! @note a modification made by another instance is detected
+      cu0::EnvironmentVariable::unsynced("SOME_LOG_LEVEL").set("debug");
+    }
+  }
+  std::cout << "SOME_LOG_LEVEL=" <<
+      log_level.cached().value_or("<not-set>") << '\n';
+}
@@ -0,0 +1,17 @@
+#include <cu0/env/environment.hh>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the view refers to the actual environment =>
+  //!     nothing is copied, but the view must not be used after
+  //!     the environment is modified
+  const auto environment = cu0::Environment::as<cu0::EnvironmentView>();
+  for (const auto& [key, value] : environment) {
+    std::cout << "environment[" << key << "]" << "=" << value << '\n';
+  }
+  const auto home = environment.find("HOME");
+  if (home.has_value()) {
+    std::cout << "HOME=" << home.value() << '\n';
+  }
+}
@@ -0,0 +1,32 @@
+#include <cu0/proc/executable_cache.hh>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+cu0::ExecutableCache will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  auto cache = cu0::ExecutableCache{};
+  for (auto i = 0; i < 8; i++) {
+    //! @note directories are searched only on the first call and
+    //!     after PATH, the current directory or a searched directory changes
+    //!     which is checked at most once per second
+    const auto executable = cache.find_by("some_executable_name");
+    if (executable.binary.empty()) {
+      std::cout << "Executable with the specified name was not found" << '\n';
+      return 1;
+    }
+    std::cout << "Path to the executable: " << executable.binary << '\n';
+  }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include <cu0/proc/executable_handle.hh>
+#include <cu0/proc/process.hh>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if \
+    !__has_include(<fcntl.h>) || \
+    !__has_include(<sys/mman.h>) || \
+    !__has_include(<sys/sendfile.h>) || \
+    !__has_include(<sys/syscall.h>)
+#warning <fcntl.h> or <sys/mman.h> or <sys/sendfile.h> or <sys/syscall.h> is \
+not found => cu0::ExecutableHandle will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the binary is copied into memory =>
+  //!     its filesystem is not accessed when it is run
+  //! @note use cu0::ExecutableHandle::open() to skip only path resolution
+  auto loaded = cu0::ExecutableHandle::load("/usr/bin/some_executable");
+  if (!std::holds_alternative<cu0::ExecutableHandle>(loaded)) {
+    std::cout << "Error: the binary was not loaded" << '\n';
+    return 1;
+  }
+  const auto& handle = std::get<cu0::ExecutableHandle>(loaded);
+  auto options = cu0::SpawnOptions{};
+  options.binary = handle.fd();
+  for (auto i = 0; i < 8; i++) {
+    auto variant = cu0::Process::create_pipeless(
+        cu0::Executable{
+          .binary = "some_executable",
+          .arguments = { std::to_string(i), },
+        },
+        options
+    );
+    if (!std::holds_alternative<cu0::Process>(variant)) {
+      std::cout << "Error: the process was not created" << '\n';
+      return 2;
+    }
+    std::get<cu0::Process>(variant).wait();
+  }
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include <cu0/proc/executable_index.hh>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if !__has_include(<dirent.h>)
+#warning <dirent.h> is not found => \
+cu0::ExecutableIndex will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the current directory and the directories specified by
+  //!     the PATH environment variable are read once
+  const auto index = cu0::ExecutableIndex::create();
+  const auto names = std::vector<std::string>{
+    "some_executable_name",
+    "other_executable_name",
+  };
+  for (const auto& name : names) {
+    //! @note answered from memory
+    const auto executable = index.find_by(name);
+    if (executable.binary.empty()) {
+      std::cout << "Executable " << name << " was not found" << '\n';
+    } else {
+      std::cout << "Path to the executable: " << executable.binary << '\n';
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,27 @@
+#include <cu0/env/environment.hh>
+#include <cu0/proc/process.hh>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the environment is copied once into one buffer sorted by keys
+  auto environment = cu0::Environment::as<cu0::FlatEnvironment>();
+  environment.set("SOME_LOG_LEVEL", "debug");
+  environment.unset("SOME_SECRET");
+  //! @note a lookup is a binary search
+  std::cout << "SOME_LOG_LEVEL="
+      << environment.find("SOME_LOG_LEVEL").value_or("unset") << '\n';
+  //! @note the environment vector is kept up to date =>
+  //!     it is not formatted when the process is created
+  auto options = cu0::SpawnOptions{};
+  options.environment = cu0::EnvironmentOverlay::of(environment.view());
+  auto variant = cu0::Process::create_pipeless(
+      cu0::Executable{ .binary = "/usr/bin/some_executable", },
+      options
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  std::get<cu0::Process>(variant).wait();
+}
@@ -0,0 +1,41 @@
+#include <cu0/proc/fork_server.hh>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if !__has_include(<sys/socket.h>) || !__has_include(<sys/syscall.h>)
+#warning <sys/socket.h> or <sys/syscall.h> is not found => \
+cu0::ForkServer will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note launch the fork server while the process is small and
+  //!     before other threads are created
+  auto launched = cu0::ForkServer::launch();
+  if (!std::holds_alternative<cu0::ForkServer>(launched)) {
+    std::cout << "Error: the fork server was not launched" << '\n';
+    return 1;
+  }
+  const auto& fork_server = std::get<cu0::ForkServer>(launched);
+  //! @note processes are created by the helper process of the fork server
+  //!     but they are children of this process
+  auto variant = fork_server.create(cu0::Executable{
+    .binary = "some_executable"
+  });
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 2;
+  }
+  auto& some_process = std::get<cu0::Process>(variant);
+  some_process.wait();
+  std::cout << "Stdout of the created process: " << some_process.stdout() <<
+      '\n';
+}
+
+#endif
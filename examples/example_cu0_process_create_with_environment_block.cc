@@ -0,0 +1,32 @@
+#include <cu0/proc/process.hh>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the environment is formatted once and shared by all the processes
+  auto options = cu0::SpawnOptions{};
+  options.environment_block = cu0::EnvironmentBlock::of(
+      std::map<std::string, std::string>{
+        { "PATH", "/usr/bin", },
+        { "SOME_LOG_LEVEL", "debug", },
+      }
+  );
+  auto processes = std::vector<cu0::Process>{};
+  for (auto i = 0; i < 100; i++) {
+    auto variant = cu0::Process::create_pipeless(
+        cu0::Executable{ .binary = "/usr/bin/some_executable", },
+        options
+    );
+    if (!std::holds_alternative<cu0::Process>(variant)) {
+      std::cout << "Error: the process was not created" << '\n';
+      continue;
+    }
+    processes.push_back(std::move(std::get<cu0::Process>(variant)));
+  }
+  for (auto& process : processes) {
+    process.wait();
+  }
+}
@@ -0,0 +1,22 @@
+#include <cu0/proc/process.hh>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the process gets the environment of this process with
+  //!     two modifications, the environment of this process is not copied
+  auto options = cu0::SpawnOptions{};
+  options.environment = cu0::EnvironmentOverlay::current();
+  options.environment.value()
+      .set("SOME_LOG_LEVEL", "debug")
+      .unset("SOME_SECRET");
+  auto variant = cu0::Process::create_pipeless(
+      cu0::Executable{ .binary = "/usr/bin/some_executable", },
+      options
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  std::get<cu0::Process>(variant).wait();
+}
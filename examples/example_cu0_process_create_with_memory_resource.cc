@@ -0,0 +1,32 @@
+#include <cu0/proc/process.hh>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note argument and environment vectors of the process and its output
+  //!     are allocated in the buffer instead of the heap
+  auto buffer = std::array<std::byte, 1 << 16>{};
+  auto arena = std::pmr::monotonic_buffer_resource{
+    buffer.data(),
+    buffer.size(),
+  };
+  auto options = cu0::SpawnOptions{};
+  options.resource = &arena;
+  auto variant = cu0::Process::create(
+      cu0::Executable{
+        .binary = "/usr/bin/some_executable",
+        .arguments = { "some_argument", },
+      },
+      options
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  auto& process = std::get<cu0::Process>(variant);
+  process.wait();
+  std::cout << process.stdout(&arena) << '\n';
+}
@@ -0,0 +1,29 @@
+#include <cu0/proc/process.hh>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note an empty option is inherited from this process
+  auto options = cu0::SpawnOptions{};
+  //! @note a background process runs only on the first CPU with the lowest
+  //!     priorities, i.e. it does not interfere with other work of the host
+  options.affinity = cpu_set_t{};
+  CPU_ZERO(&options.affinity.value());
+  CPU_SET(0, &options.affinity.value());
+  options.policy = cu0::SpawnOptions::Policy::IDLE;
+  options.nice = 19;
+  options.io_priority = cu0::SpawnOptions::IoPriority{
+    .io_class = cu0::SpawnOptions::IoClass::IDLE,
+  };
+  auto variant = cu0::Process::create_pipeless(
+      cu0::Executable{
+        .binary = "some_executable"
+      },
+      options
+  );
+  if (!std::holds_alternative<cu0::Process>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+  std::get<cu0::Process>(variant).wait();
+}
@@ -0,0 +1,44 @@
+#include <cu0/proc/reaper.hh>
+#include <iostream>
+
+//! @note supported features may vary on different platforms
+//! @note
+//!     if some feature is not supported =>
+//!         a compile-time warning will be present
+//!     else (if all features are supported) =>
+//!         no feature-related compile-time warnings will be present
+#if \
+    !__has_include(<poll.h>) || \
+    !__has_include(<sys/eventfd.h>) || \
+    !__has_include(<sys/syscall.h>) || \
+    !__has_include(<sys/types.h>) || \
+    !__has_include(<sys/wait.h>)
+#warning <poll.h> or <sys/eventfd.h> or <sys/syscall.h> or <sys/types.h> or \
+<sys/wait.h> is not found => cu0::Reaper will not be used in this example
+int main() {}
+#else
+
+int main() {
+  //! @note not supported on all platforms yet
+  auto& reaper = cu0::Reaper::instance();
+  //! @note the created process is waited by the reaper =>
+  //!     it does not need to be tracked and does not remain a zombie
+  //! @note the callback is optional and is called by the thread of the reaper
+  const auto variant = reaper.create(
+      cu0::Executable{
+        .binary = "some_executable"
+      },
+      [](const cu0::Process& process){
+        if (process.exit_code().has_value()) {
+          std::cout << "Exit status code of the created process: " <<
+              process.exit_code().value() << '\n';
+        }
+      }
+  );
+  if (!std::holds_alternative<unsigned>(variant)) {
+    std::cout << "Error: the process was not created" << '\n';
+    return 1;
+  }
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include <cu0/platform/cpu_topology.hh>
+#include <cu0/proc/strand.hh>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the strand is pinned to all the SMT siblings of the first core =>
+  //!     it is not migrated to other cores by the scheduler
+  const auto topology_variant = cu0::CpuTopology::read();
+  if (!std::holds_alternative<cu0::CpuTopology>(topology_variant)) {
+    std::cerr << "Error: the topology couldn't be read" << '\n';
+    return 1;
+  }
+  const auto& topology = std::get<cu0::CpuTopology>(topology_variant);
+  auto strand_variant = cu0::Strand::create([]() {
+    std::cout << "Hello from a pinned strand" << '\n';
+  });
+  if (!std::holds_alternative<cu0::Strand>(strand_variant)) {
+    std::cerr << "Error: the strand couldn't be created" << '\n';
+    return 1;
+  }
+  auto& strand = std::get<cu0::Strand>(strand_variant);
+  const auto affinity_variant =
+      strand.affinity<cu0::Strand::Stage::NOT_LAUNCHED>(
+          cu0::CpuTopology::set_of(topology.cores().front())
+      );
+  if (!std::holds_alternative<std::monostate>(affinity_variant)) {
+    std::cerr << "Error: the affinity couldn't be set" << '\n';
+    return 1;
+  }
+  const auto run_variant = strand.run();
+  if (!std::holds_alternative<std::monostate>(run_variant)) {
+    std::cerr << "Error: the strand couldn't be launched" << '\n';
+    return 1;
+  }
+  const auto join_variant = strand.join();
+  if (!std::holds_alternative<std::monostate>(join_variant)) {
+    std::cerr << "Error: the strand couldn't be joined" << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,21 @@
+#include <cu0/proc/strand.hh>
+#include <future>
+#include <iostream>
+
+int main() {
+  //! @note the task owns the promise => std::function could not store it
+  //! @note a small task is stored inside the strand => no allocation is made
+  auto promise = std::promise<int>{};
+  auto future = promise.get_future();
+  auto variant = cu0::Strand::create([promise = std::move(promise)]() mutable {
+    promise.set_value(42);
+  });
+  if (!std::holds_alternative<cu0::Strand>(variant)) {
+    std::cerr << "Error: the strand couldn't be created" << '\n';
+    return 1;
+  }
+  auto& strand = std::get<cu0::Strand>(variant);
+  strand.run();
+  std::cout << future.get() << '\n';
+  strand.join();
+}
@@ -0,0 +1,23 @@
+#include <cu0/proc/strand_pool.hh>
+#include <atomic>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note the tasks are executed by a strand per processor instead of
+  //!     a strand per task
+  auto sum = std::atomic<int>{0};
+  {
+    auto variant = cu0::StrandPool::create({});
+    if (!std::holds_alternative<cu0::StrandPool>(variant)) {
+      std::cerr << "Error: the pool couldn't be created" << '\n';
+      return 1;
+    }
+    auto& pool = std::get<cu0::StrandPool>(variant);
+    for (auto i = 1; i <= 100; i++) {
+      pool.submit([&sum, i]() { sum += i; });
+    }
+    //! the pool executes the submitted tasks before it is destructed
+  }
+  std::cout << sum << '\n';
+}
@@ -0,0 +1,33 @@
+#include <cu0/platform/cpu_topology.hh>
+#include <cu0/proc/strand_pool.hh>
+#include <atomic>
+#include <iostream>
+
+int main() {
+  //! @note not supported on all platforms yet
+  //! @note a strand per physical core, each strand is pinned to its own core
+  //!     instead of sharing a core with another strand as its SMT sibling
+  const auto topology_variant = cu0::CpuTopology::read();
+  if (!std::holds_alternative<cu0::CpuTopology>(topology_variant)) {
+    std::cerr << "Error: the topology couldn't be read" << '\n';
+    return 1;
+  }
+  const auto& topology = std::get<cu0::CpuTopology>(topology_variant);
+  const auto size = topology.cores().size();
+  auto sum = std::atomic<int>{0};
+  {
+    auto variant = cu0::StrandPool::create({
+      .size = size,
+      .affinities = topology.spread(size),
+    });
+    if (!std::holds_alternative<cu0::StrandPool>(variant)) {
+      std::cerr << "Error: the pool couldn't be created" << '\n';
+      return 1;
+    }
+    auto& pool = std::get<cu0::StrandPool>(variant);
+    for (auto i = 1; i <= 100; i++) {
+      pool.submit([&sum, i]() { sum += i; });
+    }
+  }
+  std::cout << sum << '\n';
+}
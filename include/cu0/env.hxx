@@ -2,6 +2,14 @@
 #define CU0_ENV_HXX__
 
 #include <cu0/env/environment.hh>
+#include <cu0/env/environment_block.hh>
+#include <cu0/env/environment_index.hh>
+#include <cu0/env/environment_keys.hh>
+#include <cu0/env/environment_overlay.hh>
+#include <cu0/env/environment_store.hh>
+#include <cu0/env/environment_transaction.hh>
 #include <cu0/env/environment_variable.hh>
+#include <cu0/env/environment_view.hh>
+#include <cu0/env/flat_environment.hh>
 
 #endif /// CU0_ENV_HXX__
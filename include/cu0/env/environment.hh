@@ -9,6 +9,7 @@ cu0::Environment::as() will not be supported
 #if __has_include(<unistd.h>)
 #include <functional>
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <vector>
 #endif
@@ -19,6 +20,8 @@ cu0::Environment::as() will not be supported
 
 #if __has_include(<unistd.h>)
 #include <cu0/env/environment_variable.hh>
+#include <cu0/env/environment_view.hh>
+#include <cu0/env/flat_environment.hh>
 #endif
 
 #if __has_include(<unistd.h>)
@@ -48,6 +51,19 @@ public:
   template <class Return>
   [[nodiscard]]
   constexpr static Return as() = delete;
+  /*!
+   * @brief accesses the environment of execution and returns it as the
+   *     specified type allocated from a memory resource
+   * @note this function is marked deleted to allow only usage of
+   *     specializations
+   * @tparam Return is the type that will be returned
+   * @param resource is the memory resource of the returned environment
+   *     e.g. std::pmr::monotonic_buffer_resource of a request
+   * @return environment as Return type
+   */
+  template <class Return>
+  [[nodiscard]]
+  constexpr static Return as(std::pmr::memory_resource* resource) = delete;
 #if !CU0_DONT_COMPILE_SPECIALIZATION_DECLARATIONS_IN_STRUCT
 #if __has_include(<unistd.h>)
   /*!
@@ -73,6 +89,45 @@ public:
   [[nodiscard]]
   std::vector<EnvironmentVariable> as();
 #endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @note specialization of Environment::as()
+   * @brief creates a view of environment variables without copying them
+   * @note the view is invalidated when environment changes
+   * @return view of the current environment variables
+   */
+  template <>
+  [[nodiscard]]
+  EnvironmentView as();
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @note specialization of Environment::as()
+   * @brief copies environment variables into FlatEnvironment
+   * @note the behaviour is undefined if environment changes during function
+   *     execution
+   * @return flat environment of the current environment variables
+   */
+  template <>
+  [[nodiscard]]
+  FlatEnvironment as();
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @note specialization of Environment::as(std::pmr::memory_resource*)
+   * @brief copies environment variables into
+   *     std::pmr::map<std::pmr::string, std::pmr::string>
+   * @note the behaviour is undefined if environment changes during function
+   *     execution
+   * @param resource is the memory resource of the map and its strings
+   * @return map of the current environment variables in the form <key, value>
+   */
+  template <>
+  [[nodiscard]]
+  std::pmr::map<std::pmr::string, std::pmr::string> as(
+      std::pmr::memory_resource* resource
+  );
+#endif
 #endif
 protected:
 #if __has_include(<unistd.h>)
@@ -102,6 +157,20 @@ private:
 
 namespace cu0 {
 
+#if __has_include(<unistd.h>)
+template <>
+inline EnvironmentView Environment::as() {
+  return EnvironmentView::of(environ);
+}
+#endif
+
+#if __has_include(<unistd.h>)
+template <>
+inline FlatEnvironment Environment::as() {
+  return FlatEnvironment::of(Environment::as<EnvironmentView>());
+}
+#endif
+
 #if __has_include(<unistd.h>)
 template <>
 inline std::map<std::string, std::string> Environment::as() {
@@ -115,6 +184,20 @@ inline std::map<std::string, std::string> Environment::as() {
 }
 #endif
 
+#if __has_include(<unistd.h>)
+template <>
+inline std::pmr::map<std::pmr::string, std::pmr::string> Environment::as(
+    std::pmr::memory_resource* resource
+) {
+  //! the map propagates its resource to the strings it constructs
+  auto ret = std::pmr::map<std::pmr::string, std::pmr::string>{resource};
+  for (const auto& [key, value] : Environment::as<EnvironmentView>()) {
+    ret.emplace(key, value);
+  }
+  return ret;
+}
+#endif
+
 #if __has_include(<unistd.h>)
 template <>
 inline std::vector<EnvironmentVariable> Environment::as() {
@@ -134,13 +217,9 @@ constexpr Return Environment::as(
     const std::function<void(Return&, std::string&&, std::string&&)>& insert
 ) {
   auto ret = Return{};
-  for (char** envp = environ; *envp != NULL; envp++) {
-    const auto string = std::string{*envp};
-    constexpr auto DELIMETER = '=';
-    const auto delimeterPos = string.find(DELIMETER);
-    auto key = string.substr(0, delimeterPos);
-    auto value = string.substr(delimeterPos + 1);
-    insert(ret, std::move(key), std::move(value));
+  //! key and value are copied from the view only once
+  for (const auto& [key, value] : Environment::as<EnvironmentView>()) {
+    insert(ret, std::string{key}, std::string{value});
   }
   return ret;
 }
@@ -0,0 +1,168 @@
+#ifndef CU0_ENVIRONMENT_BLOCK_HH__
+#define CU0_ENVIRONMENT_BLOCK_HH__
+
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentBlock::current() will not be supported
+#endif
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_view.hh>
+
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
+namespace cu0 {
+
+/*!
+ * @brief The EnvironmentBlock struct represents an immutable environment
+ *     vector which is formatted once and shared by copies of the block
+ * @note a copy of the block is a reference count increment =>
+ *     the block can be passed to many processes without formatting
+ *     @see SpawnOptions::environment_block
+ */
+struct EnvironmentBlock {
+public:
+  /*!
+   * @brief creates a block with a copy of the specified environment
+   * @param view is the view of an environment
+   * @return created block
+   */
+  [[nodiscard]]
+  static EnvironmentBlock of(const EnvironmentView& view);
+  /*!
+   * @brief creates a block with a copy of the specified environment
+   *     @see Executable::environment
+   * @param environment is the environment in the form <key, value>
+   * @return created block
+   */
+  [[nodiscard]]
+  static EnvironmentBlock of(
+      const std::map<std::string, std::string>& environment
+  );
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a block with a copy of the current environment
+   * @note the behaviour is undefined if environment changes during function
+   *     execution
+   * @return created block
+   */
+  [[nodiscard]]
+  static EnvironmentBlock current();
+#endif
+  /*!
+   * @brief accesses the environment vector
+   * @return NULL-terminated array of "key=value" strings valid while
+   *     a copy of the block exists
+   */
+  [[nodiscard]]
+  char* const* envp() const;
+  /*!
+   * @brief accesses the environment variables
+   * @return view of the environment variables valid while a copy of
+   *     the block exists
+   */
+  [[nodiscard]]
+  EnvironmentView view() const;
+  /*!
+   * @brief accesses the number of environment variables
+   * @return number of environment variables
+   */
+  [[nodiscard]]
+  std::size_t size() const;
+protected:
+  //! formatted environment shared by copies of a block
+  struct Data {
+    //! "key=value" strings separated by '\0'
+    std::string strings{};
+    //! NULL-terminated pointers to the strings
+    std::vector<char*> envp{};
+  };
+  /*!
+   * @brief constructs a block of the specified data
+   * @param data is the data to be shared
+   */
+  explicit EnvironmentBlock(std::shared_ptr<const Data> data);
+  /*!
+   * @brief takes pointers to the strings of data after the strings are
+   *     formatted
+   * @param data is the data with formatted strings
+   * @param size is the number of strings
+   */
+  static void point(Data& data, const std::size_t& size);
+  //! formatted environment
+  std::shared_ptr<const Data> data_;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline EnvironmentBlock EnvironmentBlock::of(const EnvironmentView& view) {
+  auto data = std::make_shared<Data>();
+  auto size = std::size_t{0};
+  for (const auto& [key, value] : view) {
+    data->strings.append(key).append("=").append(value);
+    data->strings.push_back('\0');
+    size++;
+  }
+  EnvironmentBlock::point(*data, size);
+  return EnvironmentBlock{std::move(data)};
+}
+
+inline EnvironmentBlock EnvironmentBlock::of(
+    const std::map<std::string, std::string>& environment
+) {
+  auto data = std::make_shared<Data>();
+  for (const auto& [key, value] : environment) {
+    data->strings.append(key).append("=").append(value);
+    data->strings.push_back('\0');
+  }
+  EnvironmentBlock::point(*data, environment.size());
+  return EnvironmentBlock{std::move(data)};
+}
+
+#if __has_include(<unistd.h>)
+inline EnvironmentBlock EnvironmentBlock::current() {
+  return EnvironmentBlock::of(EnvironmentView::of(environ));
+}
+#endif
+
+inline char* const* EnvironmentBlock::envp() const {
+  return this->data_->envp.data();
+}
+
+inline EnvironmentView EnvironmentBlock::view() const {
+  return EnvironmentView::of(this->data_->envp.data());
+}
+
+inline std::size_t EnvironmentBlock::size() const {
+  return this->data_->envp.size() - 1;
+}
+
+inline EnvironmentBlock::EnvironmentBlock(std::shared_ptr<const Data> data)
+    : data_{std::move(data)} {}
+
+inline void EnvironmentBlock::point(Data& data, const std::size_t& size) {
+  //! pointers are taken after strings is not reallocated anymore
+  data.envp.reserve(size + 1);
+  for (auto offset = std::size_t{0}; offset < data.strings.size();) {
+    data.envp.push_back(data.strings.data() + offset);
+    offset += std::char_traits<char>::length(data.strings.data() + offset) + 1;
+  }
+  data.envp.push_back(nullptr);
+}
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_BLOCK_HH__
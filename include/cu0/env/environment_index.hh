@@ -0,0 +1,313 @@
+#ifndef CU0_ENVIRONMENT_INDEX_HH__
+#define CU0_ENVIRONMENT_INDEX_HH__
+
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentIndex::current() will not be supported
+#endif
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_view.hh>
+
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
+namespace cu0 {
+
+/*!
+ * @brief The EnvironmentIndex struct provides a way to find values of
+ *     environment variables by keys in constant time
+ * @note the index refers to the environment block directly =>
+ *     the index is invalidated when the environment block is modified
+ *     @see EnvironmentIndex::current()
+ */
+struct EnvironmentIndex {
+public:
+  /*!
+   * @brief creates an index of the specified environment
+   * @param view is the view of an environment block
+   * @return index of the environment block
+   */
+  [[nodiscard]]
+  static EnvironmentIndex of(const EnvironmentView& view);
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief accesses the index of the current environment of the calling
+   *     thread
+   * @note the index is rebuilt on access if the environment has been modified
+   *     by EnvironmentVariable::set() or EnvironmentVariable::unset() or
+   *     if environ has been reallocated, other modifications are not detected
+   * @return index as a const reference valid until the next call to this
+   *     function by the calling thread
+   */
+  [[nodiscard]]
+  static const EnvironmentIndex& current();
+  /*!
+   * @brief finds the value of an environment variable in the current
+   *     environment of the calling thread @see current()
+   * @note the entry of the found value is checked to be still in
+   *     the environment block => modifications made without cu0
+   *     (e.g. by ::setenv()) are detected and the index is rebuilt
+   * @note no memory is allocated unless the index is rebuilt
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is found => value valid until the next
+   *         call to this function or current() by the calling thread
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static std::optional<std::string_view> find_current(std::string_view key);
+#endif
+  /*!
+   * @brief finds the value of an environment variable
+   * @note no memory is allocated
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is found => value
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  std::optional<std::string_view> find(std::string_view key) const;
+  /*!
+   * @brief accesses the number of indexed environment variables
+   * @return number of environment variables
+   */
+  [[nodiscard]]
+  std::size_t size() const;
+protected:
+  friend struct EnvironmentVariable;
+  //! slot of the open addressing table
+  struct Slot {
+    //! hash of the key
+    std::uint64_t hash = 0;
+    //! key of the environment variable
+    //! @note if data() is NULL => the slot is empty
+    std::string_view key{};
+    //! value of the environment variable
+    std::string_view value{};
+    //! position of the entry in the environment block
+    std::size_t position = 0;
+  };
+  /*!
+   * @brief hashes a key @see FNV-1a
+   * @param key is the key to hash
+   * @return hash of the key
+   */
+  [[nodiscard]]
+  static constexpr std::uint64_t hash(std::string_view key);
+  /*!
+   * @brief accesses the counter of modifications of the environment made by
+   *     EnvironmentVariable::set() and EnvironmentVariable::unset()
+   *     @see EnvironmentVariable::generation()
+   * @note the index is rebuilt when the counter changes
+   * @return counter as a mutable reference
+   */
+  [[nodiscard]]
+  static std::atomic<std::uint64_t>& modifications();
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief accesses the index of the current environment of the calling
+   *     thread @see current()
+   * @param rebuild is true if the index should be rebuilt unconditionally
+   * @return index as a const reference valid until the next call to this
+   *     function by the calling thread
+   */
+  [[nodiscard]]
+  static const EnvironmentIndex& current(const bool& rebuild);
+#endif
+  /*!
+   * @brief finds the slot of an environment variable
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is found => slot as a const pointer
+   *     else => NULL
+   */
+  [[nodiscard]]
+  const Slot* slot_of(std::string_view key) const;
+  /*!
+   * @brief checks if the result of a search still describes
+   *     the environment block in O(1)
+   * @note a found entry is checked to be at its position and a missing one
+   *     to be not appended after the last entry
+   * @param slot is the result of a search @see slot_of()
+   * @return true if the result is valid else false
+   */
+  [[nodiscard]]
+  bool describes(const Slot* slot) const;
+  /*!
+   * @brief constructs an empty index
+   */
+  EnvironmentIndex() = default;
+  //! table with a size of a power of 2, linear probing is used
+  std::vector<Slot> slots_{};
+  //! number of occupied slots
+  std::size_t size_ = 0;
+  //! environment block of the index
+  char* const* envp_ = nullptr;
+  //! number of entries of the environment block
+  std::size_t entries_ = 0;
+  //! last entry of the environment block
+  //! @note if NULL => the environment block is empty
+  const char* last_ = nullptr;
+  //! modifications() when the index is created
+  std::uint64_t generation_ = 0;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline EnvironmentIndex EnvironmentIndex::of(const EnvironmentView& view) {
+  auto ret = EnvironmentIndex{};
+  ret.generation_ =
+      EnvironmentIndex::modifications().load(std::memory_order_acquire);
+  //! at most a half of the slots is occupied
+  ret.slots_.resize(std::bit_ceil(view.size() * 2 + 1));
+  const auto mask = ret.slots_.size() - 1;
+  auto position = std::size_t{0};
+  for (const auto& [key, value] : view) {
+    const auto hash = EnvironmentIndex::hash(key);
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+      auto& slot = ret.slots_[i];
+      if (slot.key.data() == nullptr) {
+        slot = {
+          .hash = hash,
+          .key = key,
+          .value = value,
+          .position = position,
+        };
+        ret.size_++;
+        break;
+      }
+      //! the first entry of a key is used as by ::getenv()
+      if (slot.hash == hash && slot.key == key) {
+        break;
+      }
+    }
+    position++;
+  }
+  return ret;
+}
+
+#if __has_include(<unistd.h>)
+inline const EnvironmentIndex& EnvironmentIndex::current() {
+  return EnvironmentIndex::current(false);
+}
+
+inline std::optional<std::string_view> EnvironmentIndex::find_current(
+    std::string_view key
+) {
+  const auto* index = &EnvironmentIndex::current();
+  auto slot = index->slot_of(key);
+  if (!index->describes(slot)) {
+    index = &EnvironmentIndex::current(true);
+    slot = index->slot_of(key);
+  }
+  if (slot == nullptr) {
+    return {};
+  }
+  return slot->value;
+}
+
+inline const EnvironmentIndex& EnvironmentIndex::current(
+    const bool& rebuild
+) {
+  //! an index per thread => no synchronization between readers
+  thread_local auto index = EnvironmentIndex{};
+  if (
+      rebuild ||
+      index.slots_.empty() ||
+      index.envp_ != environ ||
+      index.generation_ !=
+          EnvironmentIndex::modifications().load(std::memory_order_acquire)
+  ) {
+    const auto view = EnvironmentView::of(environ);
+    index = EnvironmentIndex::of(view);
+    index.envp_ = environ;
+    index.entries_ = view.size();
+    index.last_ = index.entries_ == 0 ? nullptr : environ[index.entries_ - 1];
+  }
+  return index;
+}
+#endif
+
+inline std::optional<std::string_view> EnvironmentIndex::find(
+    std::string_view key
+) const {
+  const auto* slot = this->slot_of(key);
+  if (slot == nullptr) {
+    return {};
+  }
+  return slot->value;
+}
+
+inline std::size_t EnvironmentIndex::size() const {
+  return this->size_;
+}
+
+inline const typename EnvironmentIndex::Slot* EnvironmentIndex::slot_of(
+    std::string_view key
+) const {
+  if (this->slots_.empty()) {
+    return nullptr;
+  }
+  const auto hash = EnvironmentIndex::hash(key);
+  const auto mask = this->slots_.size() - 1;
+  for (auto i = hash & mask;; i = (i + 1) & mask) {
+    const auto& slot = this->slots_[i];
+    if (slot.key.data() == nullptr) {
+      return nullptr;
+    }
+    if (slot.hash == hash && slot.key == key) {
+      return &slot;
+    }
+  }
+}
+
+inline bool EnvironmentIndex::describes(const Slot* slot) const {
+  if (this->envp_ == nullptr) {
+    return false;
+  }
+  //! ::setenv() replaces the entry of a key in place,
+  //!     ::unsetenv() moves the following entries in place
+  if (slot != nullptr) {
+    return this->envp_[slot->position] == slot->key.data();
+  }
+  //! a new key is appended after the last entry
+  return
+      this->envp_[this->entries_] == nullptr &&
+      (
+          this->entries_ == 0 ||
+          this->envp_[this->entries_ - 1] == this->last_
+      );
+}
+
+inline std::atomic<std::uint64_t>& EnvironmentIndex::modifications() {
+  static auto counter = std::atomic<std::uint64_t>{0};
+  return counter;
+}
+
+constexpr std::uint64_t EnvironmentIndex::hash(std::string_view key) {
+  auto ret = std::uint64_t{14695981039346656037ull};
+  for (const auto& c : key) {
+    ret ^= static_cast<unsigned char>(c);
+    ret *= 1099511628211ull;
+  }
+  return ret;
+}
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_INDEX_HH__
@@ -0,0 +1,311 @@
+#ifndef CU0_ENVIRONMENT_KEYS_HH__
+#define CU0_ENVIRONMENT_KEYS_HH__
+
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentKeys::synced() will not be supported
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentKeys::sync() will not be supported
+#endif
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_variable.hh>
+
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
+namespace cu0 {
+
+/*!
+ * @brief The EnvironmentKeys struct represents the environment variables of
+ *     keys known at compile time
+ * @note a perfect hash of the keys is built at compile time =>
+ *     a key is found by one hash and one comparison, and an index of a key
+ *     known at compile time is a constant
+ * @tparam KEYS is a constexpr array of unique keys
+ *     e.g. static constexpr auto KEYS =
+ *         std::to_array<std::string_view>({ "HOME", "PATH", });
+ */
+template <const auto& KEYS>
+struct EnvironmentKeys {
+  static_assert(std::size(KEYS) > 0, "KEYS need to be non-empty");
+public:
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates an instance syncing with the environment,
+   *     the environment is read once for all the keys
+   * @return synced environment variables
+   */
+  [[nodiscard]]
+  static EnvironmentKeys synced();
+#endif
+  /*!
+   * @brief finds the index of a key
+   * @note if the key is known at compile time => the index is a constant
+   * @param key is the key to find
+   * @return
+   *     if the key is one of KEYS => index of the key in KEYS
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static constexpr std::optional<std::size_t> index_of(std::string_view key);
+  /*!
+   * @brief accesses the number of keys
+   * @return number of keys
+   */
+  [[nodiscard]]
+  static constexpr std::size_t size();
+  /*!
+   * @brief accesses an environment variable by an index
+   * @param index is the index of the key in KEYS @see index_of()
+   * @return environment variable as a const reference
+   */
+  [[nodiscard]]
+  const EnvironmentVariable& at(const std::size_t& index) const;
+  /*!
+   * @brief finds an environment variable by a key
+   * @param key is the key of the environment variable
+   * @return
+   *     if the key is one of KEYS => environment variable as a const pointer
+   *     else => NULL
+   */
+  [[nodiscard]]
+  const EnvironmentVariable* find(std::string_view key) const;
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief syncs cached values of all the environment variables reading
+   *     the environment once
+   */
+  void sync();
+#endif
+protected:
+  //! perfect hash table @see hash and displace
+  struct Table {
+    //! seed of the second hash per bucket
+    std::array<std::uint64_t, std::size(KEYS)> seeds{};
+    //! index of a key per slot
+    //! @note if equal to std::size(KEYS) => the slot is empty
+    std::array<std::size_t, std::bit_ceil(std::size(KEYS) + 1)> slots{};
+  };
+  /*!
+   * @brief hashes a key @see FNV-1a
+   * @param key is the key to hash
+   * @param seed is the seed of the hash
+   * @return hash of the key
+   */
+  [[nodiscard]]
+  static constexpr std::uint64_t hash(
+      std::string_view key,
+      const std::uint64_t& seed
+  );
+  /*!
+   * @brief builds the perfect hash table of KEYS
+   * @note keys are placed by buckets from the largest bucket,
+   *     the seed of a bucket is increased until its keys fall into
+   *     empty slots
+   * @return built table
+   */
+  [[nodiscard]]
+  static constexpr Table table();
+  /*!
+   * @brief creates the environment variables of KEYS without syncing
+   * @return environment variables
+   */
+  template <std::size_t... INDICES>
+  [[nodiscard]]
+  static std::array<EnvironmentVariable, sizeof...(INDICES)> unsynced(
+      std::index_sequence<INDICES...>
+  );
+  /*!
+   * @brief constructs an instance without syncing with the environment
+   */
+  EnvironmentKeys() = default;
+  //! perfect hash table of KEYS
+  static constexpr auto TABLE = EnvironmentKeys::table();
+  //! environment variables in the order of KEYS
+  std::array<EnvironmentVariable, std::size(KEYS)> variables_ =
+      EnvironmentKeys::unsynced(std::make_index_sequence<std::size(KEYS)>{});
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<unistd.h>)
+template <const auto& KEYS>
+inline EnvironmentKeys<KEYS> EnvironmentKeys<KEYS>::synced() {
+  auto ret = EnvironmentKeys{};
+  ret.sync();
+  return ret;
+}
+#endif
+
+template <const auto& KEYS>
+constexpr std::optional<std::size_t> EnvironmentKeys<KEYS>::index_of(
+    std::string_view key
+) {
+  constexpr auto& TABLE = EnvironmentKeys::TABLE;
+  const auto bucket = EnvironmentKeys::hash(key, 0) % TABLE.seeds.size();
+  const auto slot = EnvironmentKeys::hash(key, TABLE.seeds[bucket]) &
+      (TABLE.slots.size() - 1);
+  const auto index = TABLE.slots[slot];
+  //! one comparison per lookup
+  if (index == std::size(KEYS) || KEYS[index] != key) {
+    return {};
+  }
+  return index;
+}
+
+template <const auto& KEYS>
+constexpr std::size_t EnvironmentKeys<KEYS>::size() {
+  return std::size(KEYS);
+}
+
+template <const auto& KEYS>
+inline const EnvironmentVariable& EnvironmentKeys<KEYS>::at(
+    const std::size_t& index
+) const {
+  return this->variables_[index];
+}
+
+template <const auto& KEYS>
+inline const EnvironmentVariable* EnvironmentKeys<KEYS>::find(
+    std::string_view key
+) const {
+  const auto index = EnvironmentKeys::index_of(key);
+  return index.has_value() ? &this->variables_[index.value()] : nullptr;
+}
+
+#if __has_include(<unistd.h>)
+template <const auto& KEYS>
+inline void EnvironmentKeys<KEYS>::sync() {
+  //! loaded before reading => a modification made meanwhile is detected
+  const auto generation = EnvironmentVariable::generation();
+  auto values = std::array<std::optional<std::string_view>, std::size(KEYS)>{};
+  auto found = std::size_t{0};
+  for (char** envp = environ; *envp != NULL && found < values.size(); envp++) {
+    const auto entry = std::string_view{*envp};
+    const auto delimeter_pos = entry.find('=');
+    if (delimeter_pos == std::string_view::npos) {
+      continue;
+    }
+    const auto key = entry.substr(0, delimeter_pos);
+    const auto index = EnvironmentKeys::index_of(key);
+    //! the first entry of a key is used as by ::getenv()
+    if (!index.has_value() || values[index.value()].has_value()) {
+      continue;
+    }
+    values[index.value()] = entry.substr(delimeter_pos + 1);
+    found++;
+  }
+  for (auto i = 0u; i < values.size(); i++) {
+    auto& variable = this->variables_[i];
+    variable.generation_ = generation;
+    variable.parsed_.value = {};
+    if (values[i].has_value()) {
+      variable.data_.value = values[i].value();
+    } else {
+      variable.data_.value = {};
+    }
+  }
+}
+#endif
+
+template <const auto& KEYS>
+constexpr std::uint64_t EnvironmentKeys<KEYS>::hash(
+    std::string_view key,
+    const std::uint64_t& seed
+) {
+  auto ret = std::uint64_t{14695981039346656037ull} ^ seed;
+  for (const auto& c : key) {
+    ret ^= static_cast<unsigned char>(c);
+    ret *= 1099511628211ull;
+  }
+  //! low bits are used for slots => high bits are mixed in
+  ret ^= ret >> 29;
+  ret *= 0xbf58476d1ce4e5b9ull;
+  ret ^= ret >> 32;
+  return ret;
+}
+
+template <const auto& KEYS>
+constexpr typename EnvironmentKeys<KEYS>::Table
+EnvironmentKeys<KEYS>::table() {
+  constexpr auto SIZE = std::size(KEYS);
+  for (auto i = 0u; i < SIZE; i++) {
+    for (auto j = i + 1; j < SIZE; j++) {
+      if (KEYS[i] == KEYS[j]) {
+        //! not a constant expression => a compile-time error
+        throw "KEYS of cu0::EnvironmentKeys need to be unique";
+      }
+    }
+  }
+  auto ret = Table{};
+  ret.slots.fill(SIZE);
+  //! keys of each bucket
+  auto buckets = std::array<std::array<std::size_t, SIZE>, SIZE>{};
+  auto sizes = std::array<std::size_t, SIZE>{};
+  for (auto i = 0u; i < SIZE; i++) {
+    const auto bucket = EnvironmentKeys::hash(KEYS[i], 0) % SIZE;
+    buckets[bucket][sizes[bucket]++] = i;
+  }
+  //! larger buckets are placed first while there are more empty slots
+  auto order = std::array<std::size_t, SIZE>{};
+  for (auto i = 0u; i < SIZE; i++) {
+    order[i] = i;
+  }
+  for (auto i = 0u; i < SIZE; i++) {
+    for (auto j = i + 1; j < SIZE; j++) {
+      if (sizes[order[j]] > sizes[order[i]]) {
+        std::swap(order[i], order[j]);
+      }
+    }
+  }
+  const auto mask = ret.slots.size() - 1;
+  for (const auto& bucket : order) {
+    for (auto seed = std::uint64_t{1};; seed++) {
+      auto slots = std::array<std::size_t, SIZE>{};
+      auto placed = true;
+      for (auto i = 0u; i < sizes[bucket] && placed; i++) {
+        const auto& key = KEYS[buckets[bucket][i]];
+        slots[i] = EnvironmentKeys::hash(key, seed) & mask;
+        placed = ret.slots[slots[i]] == SIZE;
+        for (auto j = 0u; j < i && placed; j++) {
+          placed = slots[j] != slots[i];
+        }
+      }
+      if (placed) {
+        ret.seeds[bucket] = seed;
+        for (auto i = 0u; i < sizes[bucket]; i++) {
+          ret.slots[slots[i]] = buckets[bucket][i];
+        }
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+template <const auto& KEYS>
+template <std::size_t... INDICES>
+inline std::array<EnvironmentVariable, sizeof...(INDICES)>
+EnvironmentKeys<KEYS>::unsynced(std::index_sequence<INDICES...>) {
+  return { EnvironmentVariable::unsynced(std::string{KEYS[INDICES]})..., };
+}
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_KEYS_HH__
@@ -0,0 +1,300 @@
+#ifndef CU0_ENVIRONMENT_OVERLAY_HH__
+#define CU0_ENVIRONMENT_OVERLAY_HH__
+
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentOverlay::current() will not be supported
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_view.hh>
+
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
+namespace cu0 {
+
+/*!
+ * @brief The EnvironmentOverlay struct represents an environment as
+ *     a base environment with a few environment variables set or unset
+ * @note the base environment is not copied =>
+ *     it needs to stay valid until envp() is used
+ * @see SpawnOptions::environment
+ */
+struct EnvironmentOverlay {
+public:
+  /*!
+   * @brief creates an overlay of the specified environment
+   * @param base is the view of the base environment
+   * @return overlay without modifications
+   */
+  [[nodiscard]]
+  static EnvironmentOverlay of(const EnvironmentView& base);
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates an overlay of the current environment
+   * @note environ is read when envp() is called, not when the overlay is
+   *     created
+   * @return overlay without modifications
+   */
+  [[nodiscard]]
+  static EnvironmentOverlay current();
+#endif
+  /*!
+   * @brief sets the value of an environment variable in the overlay
+   * @note the key needs to be a non-empty string without '='
+   * @param key is the key of the environment variable
+   * @param value is the value to be set
+   * @return this overlay as a mutable reference
+   */
+  EnvironmentOverlay& set(std::string_view key, std::string_view value);
+  /*!
+   * @brief unsets an environment variable in the overlay
+   * @param key is the key of the environment variable
+   * @return this overlay as a mutable reference
+   */
+  EnvironmentOverlay& unset(std::string_view key);
+  /*!
+   * @brief finds the value of an environment variable
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is found => value
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  std::optional<std::string_view> find(std::string_view key) const;
+  /*!
+   * @brief creates an environment vector of the overlay in one pass over
+   *     the base environment
+   * @note the vector refers to the strings of the base environment and of
+   *     this overlay => no strings are copied and the vector is valid
+   *     while both are not modified, moved or destructed
+   * @return environment vector terminated by NULL
+   */
+  [[nodiscard]]
+  std::vector<char*> envp() const;
+  /*!
+   * @brief creates an environment vector of the overlay in one pass over
+   *     the base environment @see envp()
+   * @param resource is the memory resource of the vector and of the memory
+   *     used while it is created e.g. SpawnOptions::resource
+   * @return environment vector terminated by NULL
+   */
+  [[nodiscard]]
+  std::pmr::vector<char*> envp(std::pmr::memory_resource* resource) const;
+protected:
+  /*!
+   * @brief creates an environment vector of the overlay @see envp()
+   * @tparam Allocator is the allocator of the vector
+   * @param allocator is the allocator of the vector and of the memory
+   *     used while it is created
+   * @return environment vector terminated by NULL
+   */
+  template <class Allocator>
+  [[nodiscard]]
+  std::vector<char*, Allocator> collect(const Allocator& allocator) const;
+  //! modification of the base environment
+  struct Change {
+    //! "key=value" if the environment variable is set else "key"
+    std::string entry;
+    //! size of the key in entry
+    std::size_t key_size;
+    //! true if the environment variable is set else false
+    bool set;
+    /*!
+     * @brief accesses the key of the modified environment variable
+     * @return key as a string view
+     */
+    [[nodiscard]]
+    std::string_view key() const;
+  };
+  /*!
+   * @brief constructs an overlay of the current environment
+   */
+  EnvironmentOverlay() = default;
+  /*!
+   * @brief finds the modification of an environment variable
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is modified => modification
+   *     else => NULL
+   */
+  [[nodiscard]]
+  const Change* change(std::string_view key) const;
+  /*!
+   * @brief replaces the modification of an environment variable
+   * @param key is the key of the environment variable
+   * @param value is the value to be set
+   *     if empty => the environment variable is unset
+   */
+  void modify(
+      std::string_view key,
+      const std::optional<std::string_view>& value
+  );
+  //! base environment
+  //! @note if empty => environ
+  std::optional<EnvironmentView> base_{};
+  //! modifications in the order they are made, one per key
+  std::vector<Change> changes_{};
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline EnvironmentOverlay EnvironmentOverlay::of(const EnvironmentView& base) {
+  auto ret = EnvironmentOverlay{};
+  ret.base_ = base;
+  return ret;
+}
+
+#if __has_include(<unistd.h>)
+inline EnvironmentOverlay EnvironmentOverlay::current() {
+  return EnvironmentOverlay{};
+}
+#endif
+
+inline EnvironmentOverlay& EnvironmentOverlay::set(
+    std::string_view key,
+    std::string_view value
+) {
+  this->modify(key, value);
+  return *this;
+}
+
+inline EnvironmentOverlay& EnvironmentOverlay::unset(std::string_view key) {
+  this->modify(key, {});
+  return *this;
+}
+
+inline std::optional<std::string_view> EnvironmentOverlay::find(
+    std::string_view key
+) const {
+  if (const auto* change = this->change(key); change != nullptr) {
+    if (!change->set) {
+      return {};
+    }
+    return std::string_view{change->entry}.substr(change->key_size + 1);
+  }
+#if __has_include(<unistd.h>)
+  return this->base_.value_or(EnvironmentView::of(environ)).find(key);
+#else
+  return this->base_.value_or(EnvironmentView::of(nullptr)).find(key);
+#endif
+}
+
+inline std::vector<char*> EnvironmentOverlay::envp() const {
+  return this->collect(std::allocator<char*>{});
+}
+
+inline std::pmr::vector<char*> EnvironmentOverlay::envp(
+    std::pmr::memory_resource* resource
+) const {
+  return this->collect(std::pmr::polymorphic_allocator<char*>{resource});
+}
+
+template <class Allocator>
+inline std::vector<char*, Allocator> EnvironmentOverlay::collect(
+    const Allocator& allocator
+) const {
+#if __has_include(<unistd.h>)
+  const auto base = this->base_.value_or(EnvironmentView::of(environ));
+#else
+  const auto base = this->base_.value_or(EnvironmentView::of(nullptr));
+#endif
+  auto ret = std::vector<char*, Allocator>{allocator};
+  //! modifications are applied while the base is copied =>
+  //!     the order of the base is kept
+  using BoolAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<bool>;
+  auto applied = std::vector<bool, BoolAllocator>(
+      this->changes_.size(),
+      false,
+      BoolAllocator{allocator}
+  );
+  for (auto it = base.begin(); it != base.end(); ++it) {
+    const auto key = (*it).first;
+    const auto* change = this->change(key);
+    if (change == nullptr) {
+      //! the entry of the base is used as is
+      ret.push_back(const_cast<char*>(key.data()));
+      continue;
+    }
+    const auto index =
+        static_cast<std::size_t>(change - this->changes_.data());
+    //! duplicates of the key in the base are removed too
+    if (change->set && !applied[index]) {
+      ret.push_back(const_cast<char*>(change->entry.c_str()));
+    }
+    applied[index] = true;
+  }
+  for (auto i = 0u; i < this->changes_.size(); i++) {
+    if (this->changes_[i].set && !applied[i]) {
+      ret.push_back(const_cast<char*>(this->changes_[i].entry.c_str()));
+    }
+  }
+  ret.push_back(nullptr);
+  return ret;
+}
+
+inline std::string_view EnvironmentOverlay::Change::key() const {
+  return std::string_view{this->entry}.substr(0, this->key_size);
+}
+
+inline const typename EnvironmentOverlay::Change* EnvironmentOverlay::change(
+    std::string_view key
+) const {
+  //! there are few modifications => linear search
+  const auto found = std::find_if(
+      this->changes_.begin(),
+      this->changes_.end(),
+      [&key](const Change& change) {
+        return change.key() == key;
+      }
+  );
+  return found == this->changes_.end() ? nullptr : &*found;
+}
+
+inline void EnvironmentOverlay::modify(
+    std::string_view key,
+    const std::optional<std::string_view>& value
+) {
+  auto entry = std::string{key};
+  if (value.has_value()) {
+    entry.append("=").append(value.value());
+  }
+  auto change = Change{
+    .entry = std::move(entry),
+    .key_size = key.size(),
+    .set = value.has_value(),
+  };
+  const auto found = std::find_if(
+      this->changes_.begin(),
+      this->changes_.end(),
+      [&key](const Change& change) {
+        return change.key() == key;
+      }
+  );
+  if (found != this->changes_.end()) {
+    *found = std::move(change);
+  } else {
+    this->changes_.push_back(std::move(change));
+  }
+}
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_OVERLAY_HH__
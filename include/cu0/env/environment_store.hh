@@ -0,0 +1,399 @@
+#ifndef CU0_ENVIRONMENT_STORE_HH__
+#define CU0_ENVIRONMENT_STORE_HH__
+
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentStore will not be supported
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_index.hh>
+#include <cu0/env/environment_view.hh>
+
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
+namespace cu0 {
+
+#if __has_include(<unistd.h>)
+/*!
+ * @brief The EnvironmentStore struct provides a way to read and modify
+ *     environment variables from many threads without data races
+ * @note the store is a copy of environ made on the first access to the store,
+ *     modifications of the store are not applied to environ and
+ *     modifications of environ are not applied to the store
+ * @note readers do not lock: a modification publishes a new immutable
+ *     snapshot which is loaded by readers with one atomic load
+ * @note a replaced snapshot is freed by a later modification once every
+ *     registered reader has passed a quiescent state after the replacement
+ *     @see Reader::quiescent()
+ */
+struct EnvironmentStore {
+public:
+  /*!
+   * @brief enum of possible errors for set() and unset() functions
+   */
+  enum struct SetError {
+    //! key is a string of length 0, or contains an '=' character
+    INVALID = EINVAL, //! @see EINVAL
+  };
+  /*!
+   * @brief The Snapshot struct represents an immutable state of the store
+   */
+  struct Snapshot {
+  public:
+    constexpr Snapshot(const Snapshot& other) = delete;
+    constexpr Snapshot& operator =(const Snapshot& other) = delete;
+    constexpr Snapshot(Snapshot&& other) = delete;
+    constexpr Snapshot& operator =(Snapshot&& other) = delete;
+    /*!
+     * @brief finds the value of an environment variable in constant time
+     * @param key is the key of the environment variable
+     * @return
+     *     if the environment variable is found => value
+     *     else => empty optional
+     */
+    [[nodiscard]]
+    std::optional<std::string_view> find(std::string_view key) const;
+    /*!
+     * @brief accesses the environment variables of the snapshot
+     * @return view of the environment variables
+     */
+    [[nodiscard]]
+    EnvironmentView view() const;
+    /*!
+     * @brief accesses the environment block of the snapshot which can be
+     *     passed to ::execve()
+     * @return NULL-terminated array of "key=value" strings
+     */
+    [[nodiscard]]
+    char* const* envp() const;
+  protected:
+    friend struct EnvironmentStore;
+    /*!
+     * @brief constructs an empty snapshot
+     */
+    Snapshot() = default;
+    //! "key=value" strings separated by '\0'
+    std::string data_{};
+    //! NULL-terminated pointers to the strings of data_
+    std::vector<char*> envp_{};
+    //! index of envp_
+    EnvironmentIndex index_ =
+        EnvironmentIndex::of(EnvironmentView::of(nullptr));
+  private:
+  };
+  /*!
+   * @brief The Reader struct registers a reader of the store
+   * @note a reader is used by one thread at a time and
+   *     is destructed before the store
+   */
+  struct Reader {
+  public:
+    /*!
+     * @brief registers a reader of the specified store
+     * @param store is the store to be read
+     */
+    explicit Reader(EnvironmentStore& store);
+    constexpr Reader(const Reader& other) = delete;
+    constexpr Reader& operator =(const Reader& other) = delete;
+    constexpr Reader(Reader&& other) = delete;
+    constexpr Reader& operator =(Reader&& other) = delete;
+    /*!
+     * @brief unregisters the reader, snapshots loaded by the reader
+     *     may be freed
+     */
+    ~Reader();
+    /*!
+     * @brief accesses the current snapshot
+     * @note wait-free: one atomic load
+     * @return snapshot as a const reference valid until the next call to
+     *     quiescent() or the destruction of the reader
+     */
+    [[nodiscard]]
+    const Snapshot& load() const;
+    /*!
+     * @brief announces that snapshots loaded before are not used anymore =>
+     *     snapshots replaced before may be freed
+     * @note wait-free: one atomic load and one atomic store
+     */
+    void quiescent();
+  protected:
+    friend struct EnvironmentStore;
+    //! store which is read
+    EnvironmentStore* store_;
+    //! epoch of the store at the last quiescent state of the reader
+    alignas(64) std::atomic<std::uint64_t> epoch_;
+  private:
+  };
+  /*!
+   * @brief accesses the store, the store is created on the first call
+   * @return store as a mutable reference
+   */
+  [[nodiscard]]
+  static EnvironmentStore& instance();
+  constexpr EnvironmentStore(const EnvironmentStore& other) = delete;
+  constexpr EnvironmentStore& operator =(
+      const EnvironmentStore& other
+  ) = delete;
+  constexpr EnvironmentStore(EnvironmentStore&& other) = delete;
+  constexpr EnvironmentStore& operator =(EnvironmentStore&& other) = delete;
+  /*!
+   * @brief accesses the number of replaced snapshots which are not freed yet
+   * @return number of snapshots
+   */
+  [[nodiscard]]
+  std::size_t retained() const;
+  /*!
+   * @brief sets the value of an environment variable
+   * @param key is the key of the environment variable
+   * @param value is the value to be set
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, SetError> set(
+      std::string_view key,
+      std::string_view value
+  );
+  /*!
+   * @brief unsets the value of an environment variable
+   * @param key is the key of the environment variable
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, SetError> unset(std::string_view key);
+protected:
+  /*!
+   * @brief constructs an instance with a copy of the specified environment
+   * @param view is the view of the environment
+   */
+  explicit EnvironmentStore(const EnvironmentView& view);
+  /*!
+   * @brief creates a snapshot from a view with one environment variable
+   *     replaced
+   * @param view is the view of the environment to be copied
+   * @param key is the key of the environment variable to be replaced
+   *     if empty => nothing is replaced
+   * @param value is the new value of the environment variable
+   *     if empty => the environment variable is removed
+   * @return created snapshot
+   */
+  [[nodiscard]]
+  static std::unique_ptr<Snapshot> snapshot(
+      const EnvironmentView& view,
+      const std::optional<std::string_view>& key,
+      const std::optional<std::string_view>& value
+  );
+  /*!
+   * @brief replaces one environment variable and publishes a new snapshot
+   * @param key is the key of the environment variable
+   * @param value is the new value of the environment variable
+   *     if empty => the environment variable is removed
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, SetError> publish(
+      std::string_view key,
+      const std::optional<std::string_view>& value
+  );
+  /*!
+   * @brief frees the replaced snapshots which all the registered readers
+   *     have passed
+   * @note mutex_ is locked by the caller
+   */
+  void reclaim();
+  //! guards the members below and serializes writers
+  mutable std::mutex mutex_;
+  //! registered readers
+  std::vector<const Reader*> readers_{};
+  //! owner of current_
+  std::unique_ptr<Snapshot> published_{};
+  //! replaced snapshots with the epochs at which they are replaced
+  std::vector<std::pair<std::uint64_t, std::unique_ptr<Snapshot>>> retired_{};
+  //! number of replacements of the current snapshot
+  std::atomic<std::uint64_t> epoch_ = 0;
+  //! current snapshot
+  std::atomic<const Snapshot*> current_ = nullptr;
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<unistd.h>)
+inline std::optional<std::string_view>
+EnvironmentStore::Snapshot::find(std::string_view key) const {
+  return this->index_.find(key);
+}
+
+inline EnvironmentView EnvironmentStore::Snapshot::view() const {
+  return EnvironmentView::of(this->envp_.data());
+}
+
+inline char* const* EnvironmentStore::Snapshot::envp() const {
+  return this->envp_.data();
+}
+
+inline EnvironmentStore::Reader::Reader(EnvironmentStore& store)
+    : store_{&store} {
+  const auto lock = std::lock_guard{store.mutex_};
+  //! snapshots replaced after the registration are not freed before
+  //!     the next quiescent state
+  this->epoch_.store(
+      store.epoch_.load(std::memory_order_relaxed),
+      std::memory_order_relaxed
+  );
+  store.readers_.push_back(this);
+}
+
+inline EnvironmentStore::Reader::~Reader() {
+  const auto lock = std::lock_guard{this->store_->mutex_};
+  std::erase(this->store_->readers_, this);
+  this->store_->reclaim();
+}
+
+inline const typename EnvironmentStore::Snapshot&
+EnvironmentStore::Reader::load() const {
+  return *this->store_->current_.load(std::memory_order_acquire);
+}
+
+inline void EnvironmentStore::Reader::quiescent() {
+  //! the epoch is loaded before the next snapshot =>
+  //!     the next snapshot is not replaced before the loaded epoch
+  //! the snapshots loaded before are not accessed after the store
+  this->epoch_.store(
+      this->store_->epoch_.load(std::memory_order_acquire),
+      std::memory_order_release
+  );
+}
+
+inline EnvironmentStore& EnvironmentStore::instance() {
+  static auto store = EnvironmentStore{EnvironmentView::of(environ)};
+  return store;
+}
+
+inline std::size_t EnvironmentStore::retained() const {
+  const auto lock = std::lock_guard{this->mutex_};
+  return this->retired_.size();
+}
+
+inline std::variant<std::monostate, typename EnvironmentStore::SetError>
+EnvironmentStore::set(
+    std::string_view key,
+    std::string_view value
+) {
+  return this->publish(key, value);
+}
+
+inline std::variant<std::monostate, typename EnvironmentStore::SetError>
+EnvironmentStore::unset(std::string_view key) {
+  return this->publish(key, {});
+}
+
+inline EnvironmentStore::EnvironmentStore(const EnvironmentView& view) {
+  this->published_ = EnvironmentStore::snapshot(view, {}, {});
+  this->current_.store(this->published_.get(), std::memory_order_release);
+}
+
+inline std::unique_ptr<typename EnvironmentStore::Snapshot>
+EnvironmentStore::snapshot(
+    const EnvironmentView& view,
+    const std::optional<std::string_view>& key,
+    const std::optional<std::string_view>& value
+) {
+  auto ret = std::unique_ptr<Snapshot>{new Snapshot{}};
+  auto sizes = std::vector<std::size_t>{};
+  for (const auto& [entry_key, entry_value] : view) {
+    if (key.has_value() && entry_key == key.value()) {
+      continue;
+    }
+    const auto size = ret->data_.size();
+    ret->data_.append(entry_key).append("=").append(entry_value);
+    ret->data_.push_back('\0');
+    sizes.push_back(ret->data_.size() - size);
+  }
+  if (key.has_value() && value.has_value()) {
+    const auto size = ret->data_.size();
+    ret->data_.append(key.value()).append("=").append(value.value());
+    ret->data_.push_back('\0');
+    sizes.push_back(ret->data_.size() - size);
+  }
+  //! pointers are taken after data_ is not reallocated anymore
+  ret->envp_.reserve(sizes.size() + 1);
+  auto offset = std::size_t{0};
+  for (const auto& size : sizes) {
+    ret->envp_.push_back(ret->data_.data() + offset);
+    offset += size;
+  }
+  ret->envp_.push_back(nullptr);
+  ret->index_ = EnvironmentIndex::of(EnvironmentView::of(ret->envp_.data()));
+  return ret;
+}
+
+inline std::variant<std::monostate, typename EnvironmentStore::SetError>
+EnvironmentStore::publish(
+    std::string_view key,
+    const std::optional<std::string_view>& value
+) {
+  if (key.empty() || key.find('=') != std::string_view::npos) {
+    return SetError::INVALID;
+  }
+  const auto lock = std::lock_guard{this->mutex_};
+  if (this->published_->find(key) == value) {
+    return std::monostate{};
+  }
+  auto replaced = std::exchange(
+      this->published_,
+      EnvironmentStore::snapshot(this->published_->view(), key, value)
+  );
+  //! readers see a completely built snapshot
+  this->current_.store(this->published_.get(), std::memory_order_release);
+  //! a reader which loads the incremented epoch loads the new snapshot after
+  const auto epoch = this->epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  this->retired_.emplace_back(epoch, std::move(replaced));
+  this->reclaim();
+  return std::monostate{};
+}
+
+inline void EnvironmentStore::reclaim() {
+  auto oldest = std::numeric_limits<std::uint64_t>::max();
+  for (const auto* reader : this->readers_) {
+    oldest = std::min(oldest, reader->epoch_.load(std::memory_order_acquire));
+  }
+  //! a reader which has passed the epoch of a replacement does not use
+  //!     the replaced snapshot
+  std::erase_if(this->retired_, [&oldest](const auto& retired) {
+    return retired.first <= oldest;
+  });
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_STORE_HH__
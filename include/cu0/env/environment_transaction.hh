@@ -0,0 +1,255 @@
+#ifndef CU0_ENVIRONMENT_TRANSACTION_HH__
+#define CU0_ENVIRONMENT_TRANSACTION_HH__
+
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::EnvironmentTransaction will not be supported
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_variable.hh>
+
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
+namespace cu0 {
+
+#if __has_include(<unistd.h>)
+/*!
+ * @brief The EnvironmentTransaction struct provides a way to set and unset
+ *     many environment variables at once
+ * @note the modifications are applied by commit() building one new environ
+ *     array instead of one ::setenv() or ::unsetenv() per modification
+ * @note readers of cu0 see either none or all of the modifications:
+ *     EnvironmentVariable::generation() is incremented once per commit
+ * @note like ::setenv(), commit() must not be called while another thread
+ *     reads the environment
+ */
+struct EnvironmentTransaction {
+public:
+  /*!
+   * @brief enum of possible errors during commit
+   */
+  enum struct CommitError {
+    //! a key is a string of length 0, or contains an '=' character
+    INVALID = EINVAL,
+  };
+  /*!
+   * @brief creates a transaction without modifications
+   * @return created transaction
+   */
+  [[nodiscard]]
+  static EnvironmentTransaction begin();
+  /*!
+   * @brief sets the value of an environment variable when committed
+   * @param key is the key of the environment variable
+   * @param value is the value to be set
+   * @return this transaction as a mutable reference
+   */
+  EnvironmentTransaction& set(std::string_view key, std::string_view value);
+  /*!
+   * @brief unsets an environment variable when committed
+   * @param key is the key of the environment variable
+   * @return this transaction as a mutable reference
+   */
+  EnvironmentTransaction& unset(std::string_view key);
+  /*!
+   * @brief applies all the modifications to the environment replacing
+   *     environ once
+   * @note if an error is reported => no modification is applied
+   * @note the modifications are discarded after commit
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code @see CommitError
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, CommitError> commit();
+protected:
+  //! modification of an environment variable
+  struct Change {
+    //! key of the environment variable
+    std::string key;
+    //! value of the environment variable
+    //! @note if empty => the environment variable is unset
+    std::optional<std::string> value;
+  };
+  //! environ arrays and strings allocated by commits
+  struct Storage {
+    //! guards the storage and serializes commits
+    std::mutex mutex{};
+    //! "key=value" strings of the committed environment variables
+    //! @note never freed: values returned by ::getenv() stay valid
+    std::vector<std::unique_ptr<char[]>> strings{};
+    //! environ array of the last commit
+    std::unique_ptr<char*[]> envp{};
+  };
+  /*!
+   * @brief constructs a transaction without modifications
+   */
+  EnvironmentTransaction() = default;
+  /*!
+   * @brief accesses the storage of all the transactions
+   * @return storage as a mutable reference
+   */
+  [[nodiscard]]
+  static Storage& storage();
+  /*!
+   * @brief replaces the modification of an environment variable
+   * @param key is the key of the environment variable
+   * @param value is the value to be set
+   *     if empty => the environment variable is unset
+   */
+  void modify(
+      std::string_view key,
+      const std::optional<std::string_view>& value
+  );
+  //! modifications in the order they are made, one per key
+  std::vector<Change> changes_{};
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<unistd.h>)
+inline EnvironmentTransaction EnvironmentTransaction::begin() {
+  return EnvironmentTransaction{};
+}
+
+inline EnvironmentTransaction& EnvironmentTransaction::set(
+    std::string_view key,
+    std::string_view value
+) {
+  this->modify(key, value);
+  return *this;
+}
+
+inline EnvironmentTransaction& EnvironmentTransaction::unset(
+    std::string_view key
+) {
+  this->modify(key, {});
+  return *this;
+}
+
+inline std::variant<
+    std::monostate,
+    typename EnvironmentTransaction::CommitError
+> EnvironmentTransaction::commit() {
+  for (const auto& change : this->changes_) {
+    if (change.key.empty() || change.key.find('=') != std::string::npos) {
+      return CommitError::INVALID;
+    }
+  }
+  auto changes = std::move(this->changes_);
+  this->changes_.clear();
+  if (changes.empty()) {
+    return std::monostate{};
+  }
+  //! indices of the changes by keys
+  auto indices = std::unordered_map<std::string_view, std::size_t>{};
+  indices.reserve(changes.size());
+  for (auto i = 0u; i < changes.size(); i++) {
+    indices.emplace(changes[i].key, i);
+  }
+  auto& storage = EnvironmentTransaction::storage();
+  const auto lock = std::lock_guard{storage.mutex};
+  //! formats "key=value" of a change into the storage
+  const auto format = [&storage](const Change& change) {
+    const auto& value = change.value.value();
+    const auto size = change.key.size() + 1 + value.size();
+    auto string = std::make_unique<char[]>(size + 1);
+    std::memcpy(string.get(), change.key.data(), change.key.size());
+    string[change.key.size()] = '=';
+    std::memcpy(
+        string.get() + change.key.size() + 1,
+        value.data(),
+        value.size()
+    );
+    string[size] = '\0';
+    storage.strings.push_back(std::move(string));
+    return storage.strings.back().get();
+  };
+  auto envp = std::vector<char*>{};
+  auto applied = std::vector<bool>(changes.size(), false);
+  for (char** entry = environ; entry != NULL && *entry != NULL; entry++) {
+    const auto string = std::string_view{*entry};
+    const auto found = indices.find(string.substr(0, string.find('=')));
+    if (found == indices.end()) {
+      envp.push_back(*entry);
+      continue;
+    }
+    //! duplicates of the key are removed too
+    const auto& change = changes[found->second];
+    if (change.value.has_value() && !applied[found->second]) {
+      envp.push_back(format(change));
+    }
+    applied[found->second] = true;
+  }
+  for (auto i = 0u; i < changes.size(); i++) {
+    if (changes[i].value.has_value() && !applied[i]) {
+      envp.push_back(format(changes[i]));
+    }
+  }
+  envp.push_back(nullptr);
+  auto array = std::make_unique<char*[]>(envp.size());
+  std::copy(envp.begin(), envp.end(), array.get());
+  //! the previous array of a commit is not referenced anymore
+  environ = array.get();
+  storage.envp = std::move(array);
+  EnvironmentVariable::modifications().fetch_add(1, std::memory_order_release);
+  return std::monostate{};
+}
+
+inline typename EnvironmentTransaction::Storage&
+EnvironmentTransaction::storage() {
+  //! never destructed => environ stays valid until the process exits
+  static auto* storage = new Storage{};
+  return *storage;
+}
+
+inline void EnvironmentTransaction::modify(
+    std::string_view key,
+    const std::optional<std::string_view>& value
+) {
+  auto change = Change{
+    .key = std::string{key},
+    .value = value.has_value() ?
+        std::optional<std::string>{value.value()} :
+        std::optional<std::string>{},
+  };
+  const auto found = std::find_if(
+      this->changes_.begin(),
+      this->changes_.end(),
+      [&key](const Change& change) {
+        return change.key == key;
+      }
+  );
+  if (found != this->changes_.end()) {
+    *found = std::move(change);
+  } else {
+    this->changes_.push_back(std::move(change));
+  }
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_TRANSACTION_HH__
@@ -1,15 +1,40 @@
 #ifndef CU0_ENVIRONMENT_VARIABLE_HH__
 #define CU0_ENVIRONMENT_VARIABLE_HH__
 
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_index.hh>
 #include <cu0/platform/not_an_x.hh>
 
+#if __has_include(<unistd.h>)
+extern char** environ;
+#endif
+
 namespace cu0 {
 
+template <const auto& KEYS>
+struct EnvironmentKeys;
+struct EnvironmentTransaction;
+
 /*!
  * @brief The EnvironmentVariableData struct provides a way to represent
  *     environment variables in a memory
@@ -87,12 +112,70 @@ public:
    */
   [[nodiscard]]
   constexpr const std::optional<std::string>& cached() const;
+  /*!
+   * @brief parses the cached value, the parsed value is cached until
+   *     the cached value changes
+   * @note std::from_chars is used => no memory is allocated
+   * @note not thread-safe even though const: the parsed value is cached
+   * @tparam T is the type of the parsed value, one of:
+   *     an integral type, e.g. "42", "-1"
+   *     a floating-point type, e.g. "0.5", "1e-3"
+   *     bool, one of "1", "true", "yes", "on", "0", "false", "no", "off"
+   *     std::chrono::duration, an integer with an optional unit of
+   *         "ns", "us", "ms", "s", "min" or "h", e.g. "1500ms",
+   *         if the unit is missing => the unit of T is used
+   * @return
+   *     if the cached value is parsed as T entirely and fits T => parsed value
+   *     else => empty optional
+   */
+  template <class T>
+  [[nodiscard]]
+  std::optional<T> as() const;
+  /*!
+   * @brief splits the cached value by a delimiter, the parts are cached until
+   *     the cached value changes
+   * @note not thread-safe even though const: the parts are cached
+   * @param delimiter is the character separating the parts
+   * @return parts of the value as a const reference valid until the cached
+   *     value changes, empty if there is no value
+   */
+  [[nodiscard]]
+  const std::vector<std::string_view>& split(const char& delimiter = ':') const;
   /*!
    * @brief syncs cached value to the actual value of the
    *     associated environment variable
+   * @note the value is looked up in EnvironmentIndex::find_current()
    * @return new cached value as a const reference
    */
   const std::optional<std::string>& sync();
+  /*!
+   * @brief syncs cached values of the specified environment variables
+   *     looking up each key in EnvironmentIndex::find_current()
+   * @param variables are the environment variables to be synced
+   */
+  static void sync(std::span<EnvironmentVariable> variables);
+  /*!
+   * @brief accesses the number of modifications of the environment made by
+   *     set() and unset()
+   * @note may be used to detect that values read from the environment
+   *     before are outdated
+   * @return number of modifications
+   */
+  [[nodiscard]]
+  static std::uint64_t generation();
+  /*!
+   * @brief checks if the environment has been modified by set() or unset()
+   *     of any instance since the cached value of this instance is synced
+   * @note one atomic load => may be called on every access to cached()
+   * @note modifications made without cu0 (e.g. by ::setenv()) are not
+   *     detected
+   * @return
+   *     if the cached value has never been synced or the environment has been
+   *         modified since => true
+   *     else => false
+   */
+  [[nodiscard]]
+  bool is_stale() const;
 #if !defined(NOT_AN_X)
   /*!
    * @brief sets the value of the associated environment variable
@@ -113,6 +196,9 @@ public:
   std::variant<std::monostate, SetError> unset();
 #endif
 protected:
+  template <const auto& KEYS>
+  friend struct EnvironmentKeys;
+  friend struct EnvironmentTransaction;
 #if !defined(NOT_AN_X)
   /*!
    * @brief converts an error number (error code) to the ConvertTo type
@@ -129,8 +215,65 @@ protected:
    * @note does not access an actual environment variable value
    */
   constexpr EnvironmentVariable() = default;
+  /*!
+   * @brief accesses the counter of modifications of the environment
+   * @return counter as a mutable reference
+   */
+  [[nodiscard]]
+  static std::atomic<std::uint64_t>& modifications();
+  /*!
+   * @brief The Parsed struct represents the cached value parsed by as() or
+   *     split()
+   * @note the parsed value may refer to data_ of its instance =>
+   *     it is not copied or moved with the instance
+   */
+  struct Parsed {
+  public:
+    //! duration with a count and a unit
+    struct Duration {
+      //! count of units
+      std::intmax_t count;
+      //! nanoseconds in a unit
+      //! @note if 0 => no unit is specified
+      std::intmax_t unit;
+    };
+    constexpr Parsed() = default;
+    constexpr Parsed(const Parsed& other);
+    constexpr Parsed& operator =(const Parsed& other);
+    constexpr Parsed(Parsed&& other);
+    constexpr Parsed& operator =(Parsed&& other);
+    //! parsed value of any of the supported kinds
+    std::variant<
+        std::monostate,
+        std::intmax_t,
+        std::uintmax_t,
+        long double,
+        bool,
+        Duration,
+        std::pair<char, std::vector<std::string_view>>
+    > value{};
+  protected:
+  private:
+  };
+  /*!
+   * @brief parses the cached value or accesses the already parsed one
+   * @tparam Kind is the kind of the parsed value @see Parsed::value
+   * @param parse is the function parsing the cached value
+   * @return
+   *     if the cached value is parsed => parsed value as a const pointer
+   *     else => NULL
+   */
+  template <class Kind, class Parse>
+  [[nodiscard]]
+  const Kind* parsed(const Parse& parse) const;
   //! key-value data of the associated environment variable
   EnvironmentVariableData data_{};
+  //! cached value parsed by as() or split()
+  //! @note reset when data_.value changes
+  mutable Parsed parsed_{};
+  //! generation() when data_.value is synced
+  //! @note if the maximum value => data_.value has never been synced
+  std::uint64_t generation_ = std::numeric_limits<std::uint64_t>::max();
 };
 
 #if !defined(NOT_AN_X)
@@ -176,10 +319,229 @@ EnvironmentVariable::cached() const {
   return this->data_.value;
 }
 
+template <class T>
+inline std::optional<T> EnvironmentVariable::as() const {
+  using Kind = std::conditional_t<
+      std::is_same_v<T, bool>,
+      bool,
+      std::conditional_t<
+          std::is_floating_point_v<T>,
+          long double,
+          std::conditional_t<
+              std::is_unsigned_v<T>,
+              std::uintmax_t,
+              std::conditional_t<
+                  std::is_integral_v<T>,
+                  std::intmax_t,
+                  Parsed::Duration
+              >
+          >
+      >
+  >;
+  const auto* value = this->parsed<Kind>(
+      [](const std::string_view& string) -> std::optional<Kind> {
+        auto ret = Kind{};
+        const auto* end = string.data() + string.size();
+        if constexpr (std::is_same_v<Kind, bool>) {
+          if (
+              string == "1" || string == "true" ||
+              string == "yes" || string == "on"
+          ) {
+            return true;
+          }
+          if (
+              string == "0" || string == "false" ||
+              string == "no" || string == "off"
+          ) {
+            return false;
+          }
+          return {};
+        } else if constexpr (std::is_same_v<Kind, Parsed::Duration>) {
+          const auto [ptr, error] =
+              std::from_chars(string.data(), end, ret.count);
+          if (error != std::errc{}) {
+            return {};
+          }
+          const auto unit = std::string_view{ptr, end};
+          constexpr std::pair<std::string_view, std::intmax_t> UNITS[] = {
+            { "", 0, },
+            { "ns", 1, },
+            { "us", 1'000, },
+            { "ms", 1'000'000, },
+            { "s", 1'000'000'000, },
+            { "min", 60'000'000'000, },
+            { "h", 3'600'000'000'000, },
+          };
+          for (const auto& [name, nanoseconds] : UNITS) {
+            if (unit == name) {
+              ret.unit = nanoseconds;
+              return ret;
+            }
+          }
+          return {};
+        } else {
+          const auto [ptr, error] = std::from_chars(string.data(), end, ret);
+          if (error != std::errc{} || ptr != end) {
+            return {};
+          }
+          return ret;
+        }
+      }
+  );
+  if (value == nullptr) {
+    return {};
+  }
+  if constexpr (std::is_same_v<Kind, bool>) {
+    return *value;
+  } else if constexpr (std::is_same_v<Kind, long double>) {
+    //! a finite value out of the range of T would become infinite
+    constexpr auto MAX = std::numeric_limits<T>::max();
+    if (std::isfinite(*value) && (*value > MAX || *value < -MAX)) {
+      return {};
+    }
+    return static_cast<T>(*value);
+  } else if constexpr (std::is_integral_v<Kind>) {
+    if (!std::in_range<T>(*value)) {
+      return {};
+    }
+    return static_cast<T>(*value);
+  } else {
+    static_assert(
+        std::is_same_v<
+            T,
+            std::chrono::duration<typename T::rep, typename T::period>
+        >,
+        "T is not supported by EnvironmentVariable::as()"
+    );
+    using Rep = typename T::rep;
+    if (value->unit == 0) {
+      if constexpr (std::is_integral_v<Rep>) {
+        if (!std::in_range<Rep>(value->count)) {
+          return {};
+        }
+      }
+      return T{static_cast<Rep>(value->count)};
+    }
+    //! the count of nanoseconds needs to fit std::intmax_t
+    constexpr auto MAX = std::numeric_limits<std::intmax_t>::max();
+    constexpr auto MIN = std::numeric_limits<std::intmax_t>::min();
+    if (value->count > MAX / value->unit || value->count < MIN / value->unit) {
+      return {};
+    }
+    //! the count of T needs to fit T::rep
+    const auto count = std::chrono::duration_cast<
+        std::chrono::duration<long double, typename T::period>
+    >(
+        std::chrono::duration<std::intmax_t, std::nano>{
+          value->count * value->unit
+        }
+    ).count();
+    if (
+        count > static_cast<long double>(std::numeric_limits<Rep>::max()) ||
+        count < static_cast<long double>(std::numeric_limits<Rep>::lowest())
+    ) {
+      return {};
+    }
+    return std::chrono::duration_cast<T>(
+        std::chrono::duration<std::intmax_t, std::nano>{
+          value->count * value->unit
+        }
+    );
+  }
+}
+
+inline const std::vector<std::string_view>& EnvironmentVariable::split(
+    const char& delimiter
+) const {
+  using Kind = std::pair<char, std::vector<std::string_view>>;
+  auto* parts = std::get_if<Kind>(&this->parsed_.value);
+  if (parts == nullptr || parts->first != delimiter) {
+    parts = &this->parsed_.value.emplace<Kind>(
+        delimiter,
+        std::vector<std::string_view>{}
+    );
+    if (this->data_.value.has_value()) {
+      auto string = std::string_view{this->data_.value.value()};
+      for (auto pos = string.find(delimiter);; pos = string.find(delimiter)) {
+        parts->second.push_back(string.substr(0, pos));
+        if (pos == std::string_view::npos) {
+          break;
+        }
+        string.remove_prefix(pos + 1);
+      }
+    }
+  }
+  return parts->second;
+}
+
 inline const std::optional<std::string>& EnvironmentVariable::sync() {
+  //! loaded before reading => a modification made meanwhile is detected
+  this->generation_ = EnvironmentVariable::generation();
+  this->parsed_.value = {};
+#if __has_include(<unistd.h>)
+  const auto value = EnvironmentIndex::find_current(this->data_.key);
+  return this->data_.value =
+      (!value.has_value() ?
+          std::optional<std::string>{} :
+          std::string{value.value()});
+#else
   const auto* raw = std::getenv(this->data_.key.c_str());
   return this->data_.value =
       (raw == NULL ? std::optional<std::string>{} : std::string{raw});
+#endif
+}
+
+inline void EnvironmentVariable::sync(
+    std::span<EnvironmentVariable> variables
+) {
+  for (auto& variable : variables) {
+    variable.sync();
+  }
+}
+
+inline std::uint64_t EnvironmentVariable::generation() {
+  return EnvironmentVariable::modifications().load(std::memory_order_acquire);
+}
+
+inline bool EnvironmentVariable::is_stale() const {
+  return this->generation_ != EnvironmentVariable::generation();
+}
+
+inline std::atomic<std::uint64_t>& EnvironmentVariable::modifications() {
+  //! shared with EnvironmentIndex which is rebuilt when it changes
+  return EnvironmentIndex::modifications();
+}
+
+constexpr EnvironmentVariable::Parsed::Parsed(const Parsed&) {}
+
+constexpr typename EnvironmentVariable::Parsed&
+EnvironmentVariable::Parsed::operator =(const Parsed&) {
+  this->value = {};
+  return *this;
+}
+
+constexpr EnvironmentVariable::Parsed::Parsed(Parsed&&) {}
+
+constexpr typename EnvironmentVariable::Parsed&
+EnvironmentVariable::Parsed::operator =(Parsed&&) {
+  this->value = {};
+  return *this;
+}
+
+template <class Kind, class Parse>
+inline const Kind* EnvironmentVariable::parsed(const Parse& parse) const {
+  const auto* cached = std::get_if<Kind>(&this->parsed_.value);
+  if (cached != nullptr) {
+    return cached;
+  }
+  if (!this->data_.value.has_value()) {
+    return nullptr;
+  }
+  const auto value = parse(std::string_view{this->data_.value.value()});
+  if (!value.has_value()) {
+    return nullptr;
+  }
+  return &this->parsed_.value.template emplace<Kind>(value.value());
 }
 
 #if !defined(NOT_AN_X)
@@ -192,7 +554,12 @@ EnvironmentVariable::set(
       value.c_str(),
       true //! replace
   ) == 0) { //! the environment variable is set
+    this->generation_ = EnvironmentVariable::modifications().fetch_add(
+        1,
+        std::memory_order_release
+    ) + 1;
     this->data_.value = std::move(value);
+    this->parsed_.value = {};
     return std::monostate{};
   } else { //! the environment variable is not set
     return EnvironmentVariable::convert<SetError>(errno);
@@ -204,7 +571,12 @@ EnvironmentVariable::set(
 inline std::variant<std::monostate, EnvironmentVariable::SetError>
 EnvironmentVariable::unset() {
   if (unsetenv(this->data_.key.c_str()) == 0) {
+    this->generation_ = EnvironmentVariable::modifications().fetch_add(
+        1,
+        std::memory_order_release
+    ) + 1;
     this->data_.value = {};
+    this->parsed_.value = {};
     return std::monostate{};
   } else {
     return EnvironmentVariable::convert<SetError>(errno);
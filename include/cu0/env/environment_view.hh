@@ -0,0 +1,204 @@
+#ifndef CU0_ENVIRONMENT_VIEW_HH__
+#define CU0_ENVIRONMENT_VIEW_HH__
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace cu0 {
+
+/*!
+ * @brief The EnvironmentView struct provides a way to read an environment
+ *     without copying it
+ * @note the view refers to the environment block directly =>
+ *     the view and the values read from it are invalidated when
+ *     the environment block is modified (e.g. by ::setenv() or ::unsetenv())
+ * @see Environment::as()
+ */
+struct EnvironmentView {
+public:
+  //! environment variable in the form <key, value>
+  using Entry = std::pair<std::string_view, std::string_view>;
+  /*!
+   * @brief The Iterator struct iterates over the entries of an environment
+   *     block
+   */
+  struct Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Entry;
+    using pointer = void;
+    using reference = Entry;
+    /*!
+     * @brief constructs an iterator which does not refer to an entry
+     */
+    constexpr Iterator() = default;
+    /*!
+     * @brief constructs an iterator referring to the specified entry
+     * @param envp is the entry of an environment block
+     */
+    constexpr explicit Iterator(char* const* envp);
+    /*!
+     * @brief splits the current entry into a key and a value
+     * @note an entry without '=' is a key with an empty value
+     * @return current entry
+     */
+    [[nodiscard]]
+    constexpr Entry operator *() const;
+    /*!
+     * @brief moves to the next entry
+     * @return this iterator as a mutable reference
+     */
+    constexpr Iterator& operator ++();
+    /*!
+     * @brief moves to the next entry
+     * @return iterator referring to the previous entry
+     */
+    constexpr Iterator operator ++(int);
+    [[nodiscard]]
+    constexpr bool operator ==(const Iterator& other) const = default;
+    /*!
+     * @brief checks if the iterator has reached the end of the block
+     * @return true if there are no entries left else false
+     */
+    [[nodiscard]]
+    constexpr bool operator ==(const std::default_sentinel_t&) const;
+  protected:
+    //! current entry of the environment block
+    char* const* envp_ = nullptr;
+  private:
+  };
+  /*!
+   * @brief creates a view of the specified environment block
+   * @param envp is a NULL-terminated array of "key=value" strings
+   *     if NULL => the view is empty
+   * @return view of the environment block
+   */
+  [[nodiscard]]
+  static constexpr EnvironmentView of(char* const* envp);
+  /*!
+   * @brief accesses the first entry
+   * @return iterator referring to the first entry
+   */
+  [[nodiscard]]
+  constexpr Iterator begin() const;
+  /*!
+   * @brief accesses the end of the environment block
+   * @return sentinel of the environment block
+   */
+  [[nodiscard]]
+  constexpr std::default_sentinel_t end() const;
+  /*!
+   * @brief counts the entries of the environment block
+   * @return number of entries
+   */
+  [[nodiscard]]
+  constexpr std::size_t size() const;
+  /*!
+   * @brief finds the value of an environment variable
+   * @note no memory is allocated
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is found => value
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  constexpr std::optional<std::string_view> find(std::string_view key) const;
+protected:
+  /*!
+   * @brief constructs an empty view
+   */
+  constexpr EnvironmentView() = default;
+  //! environment block
+  char* const* envp_ = nullptr;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+constexpr EnvironmentView::Iterator::Iterator(char* const* envp)
+    : envp_{envp} {}
+
+constexpr typename EnvironmentView::Entry
+EnvironmentView::Iterator::operator *() const {
+  const auto string = std::string_view{*this->envp_};
+  constexpr auto DELIMETER = '=';
+  const auto delimeter_pos = string.find(DELIMETER);
+  if (delimeter_pos == std::string_view::npos) {
+    return { string, {}, };
+  }
+  return {
+    string.substr(0, delimeter_pos),
+    string.substr(delimeter_pos + 1),
+  };
+}
+
+constexpr typename EnvironmentView::Iterator&
+EnvironmentView::Iterator::operator ++() {
+  this->envp_++;
+  return *this;
+}
+
+constexpr typename EnvironmentView::Iterator
+EnvironmentView::Iterator::operator ++(int) {
+  const auto ret = *this;
+  this->envp_++;
+  return ret;
+}
+
+constexpr bool EnvironmentView::Iterator::operator ==(
+    const std::default_sentinel_t&
+) const {
+  return this->envp_ == nullptr || *this->envp_ == nullptr;
+}
+
+constexpr EnvironmentView EnvironmentView::of(char* const* envp) {
+  auto ret = EnvironmentView{};
+  ret.envp_ = envp;
+  return ret;
+}
+
+constexpr typename EnvironmentView::Iterator EnvironmentView::begin() const {
+  return Iterator{this->envp_};
+}
+
+constexpr std::default_sentinel_t EnvironmentView::end() const {
+  return std::default_sentinel;
+}
+
+constexpr std::size_t EnvironmentView::size() const {
+  auto ret = std::size_t{0};
+  for (auto it = this->begin(); it != this->end(); ++it) {
+    ret++;
+  }
+  return ret;
+}
+
+constexpr std::optional<std::string_view> EnvironmentView::find(
+    std::string_view key
+) const {
+  if (this->envp_ == nullptr) {
+    return {};
+  }
+  for (auto envp = this->envp_; *envp != nullptr; envp++) {
+    const auto* entry = *envp;
+    auto i = std::size_t{0};
+    //! the comparison stops at the end of a shorter entry
+    while (i < key.size() && entry[i] != '\0' && entry[i] == key[i]) {
+      i++;
+    }
+    if (i == key.size() && entry[i] == '=') {
+      return std::string_view{entry + i + 1};
+    }
+  }
+  return {};
+}
+
+} /// namespace cu0
+
+#endif /// CU0_ENVIRONMENT_VIEW_HH__
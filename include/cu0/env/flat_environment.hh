@@ -0,0 +1,353 @@
+#ifndef CU0_FLAT_ENVIRONMENT_HH__
+#define CU0_FLAT_ENVIRONMENT_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cu0/env/environment_view.hh>
+
+namespace cu0 {
+
+/*!
+ * @brief The FlatEnvironment struct represents environment variables as
+ *     "key=value" strings stored one after another in one buffer and
+ *     sorted by keys
+ * @note an environment vector of the environment variables is kept
+ *     up to date => it is not formatted when a process is created
+ *     @see FlatEnvironment::view() @see EnvironmentOverlay::of()
+ */
+struct FlatEnvironment {
+public:
+  /*!
+   * @brief creates an environment with a copy of the specified environment
+   * @note if a key is present many times => the first value is used
+   * @param view is the view of an environment
+   * @return created environment
+   */
+  [[nodiscard]]
+  static FlatEnvironment of(const EnvironmentView& view);
+  /*!
+   * @brief creates an environment with a copy of the specified environment
+   *     @see Executable::environment
+   * @param environment is the environment in the form <key, value>
+   * @return created environment
+   */
+  [[nodiscard]]
+  static FlatEnvironment of(
+      const std::map<std::string, std::string>& environment
+  );
+  /*!
+   * @brief constructs an empty environment
+   */
+  FlatEnvironment() = default;
+  /*!
+   * @brief copies an environment
+   * @param other is the environment to be copied
+   */
+  FlatEnvironment(const FlatEnvironment& other);
+  /*!
+   * @brief copies an environment
+   * @param other is the environment to be copied
+   * @return this environment as a mutable reference
+   */
+  FlatEnvironment& operator =(const FlatEnvironment& other);
+  /*!
+   * @brief moves environment resources to this environment
+   * @param other is the environment for which resources need to be moved
+   */
+  FlatEnvironment(FlatEnvironment&& other);
+  /*!
+   * @brief moves environment resources to this environment
+   * @param other is the environment for which resources need to be moved
+   * @return this environment as a mutable reference
+   */
+  FlatEnvironment& operator =(FlatEnvironment&& other);
+  /*!
+   * @brief finds the value of an environment variable by a binary search
+   * @param key is the key of the environment variable
+   * @return
+   *     if the environment variable is found => value
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  std::optional<std::string_view> find(std::string_view key) const;
+  /*!
+   * @brief sets the value of an environment variable
+   * @note the key needs to be a non-empty string without '='
+   * @param key is the key of the environment variable
+   * @param value is the value to be set
+   */
+  void set(std::string_view key, std::string_view value);
+  /*!
+   * @brief unsets an environment variable
+   * @param key is the key of the environment variable
+   */
+  void unset(std::string_view key);
+  /*!
+   * @brief accesses the number of environment variables
+   * @return number of environment variables
+   */
+  [[nodiscard]]
+  std::size_t size() const;
+  /*!
+   * @brief accesses the environment vector
+   * @note the vector is invalidated by set(), unset() and destruction
+   * @return NULL-terminated array of "key=value" strings sorted by keys
+   */
+  [[nodiscard]]
+  char* const* envp() const;
+  /*!
+   * @brief accesses the environment variables
+   * @note the view is invalidated by set(), unset() and destruction
+   * @return view of the environment variables sorted by keys
+   */
+  [[nodiscard]]
+  EnvironmentView view() const;
+protected:
+  //! environment variable stored in data_
+  struct Entry {
+    //! offset of "key=value" in data_
+    std::uint32_t offset;
+    //! size of the key
+    std::uint32_t key_size;
+  };
+  /*!
+   * @brief accesses the key of an environment variable
+   * @param entry is the environment variable
+   * @return key as a string view
+   */
+  [[nodiscard]]
+  std::string_view key(const Entry& entry) const;
+  /*!
+   * @brief finds the first environment variable with a key not less than
+   *     the specified key
+   * @param key is the key to find
+   * @return iterator of entries_
+   */
+  [[nodiscard]]
+  std::vector<Entry>::const_iterator lower_bound(std::string_view key) const;
+  /*!
+   * @brief appends "key=value" to data_
+   * @param key is the key of an environment variable
+   * @param value is the value of an environment variable
+   * @return environment variable referring to the appended string
+   */
+  [[nodiscard]]
+  Entry append(std::string_view key, std::string_view value);
+  /*!
+   * @brief recreates envp_ from entries_ after data_ is modified,
+   *     data_ is compacted first if most of it is not used anymore
+   */
+  void fix();
+  //! "key=value" strings separated by '\0'
+  //! @note replaced strings are kept until data_ is compacted
+  std::string data_{};
+  //! environment variables sorted by keys
+  std::vector<Entry> entries_{};
+  //! NULL-terminated pointers to the strings of entries_
+  std::vector<char*> envp_{ nullptr, };
+  //! number of bytes of data_ used by entries_
+  std::size_t used_ = 0;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline FlatEnvironment FlatEnvironment::of(const EnvironmentView& view) {
+  auto ret = FlatEnvironment{};
+  for (const auto& [key, value] : view) {
+    ret.entries_.push_back(ret.append(key, value));
+  }
+  //! the first value of a key stays first among equal keys
+  std::stable_sort(
+      ret.entries_.begin(),
+      ret.entries_.end(),
+      [&ret](const Entry& lhs, const Entry& rhs) {
+        return ret.key(lhs) < ret.key(rhs);
+      }
+  );
+  ret.entries_.erase(
+      std::unique(
+          ret.entries_.begin(),
+          ret.entries_.end(),
+          [&ret](const Entry& lhs, const Entry& rhs) {
+            return ret.key(lhs) == ret.key(rhs);
+          }
+      ),
+      ret.entries_.end()
+  );
+  //! strings of the removed duplicates are not used
+  ret.used_ = 0;
+  for (const auto& entry : ret.entries_) {
+    ret.used_ += std::string_view{ret.data_.data() + entry.offset}.size() + 1;
+  }
+  ret.fix();
+  return ret;
+}
+
+inline FlatEnvironment FlatEnvironment::of(
+    const std::map<std::string, std::string>& environment
+) {
+  auto ret = FlatEnvironment{};
+  //! a map is sorted by keys already
+  for (const auto& [key, value] : environment) {
+    ret.entries_.push_back(ret.append(key, value));
+  }
+  ret.fix();
+  return ret;
+}
+
+inline FlatEnvironment::FlatEnvironment(const FlatEnvironment& other)
+    : data_{other.data_}, entries_{other.entries_}, used_{other.used_} {
+  this->fix();
+}
+
+inline FlatEnvironment& FlatEnvironment::operator =(
+    const FlatEnvironment& other
+) {
+  if (this != &other) {
+    this->data_ = other.data_;
+    this->entries_ = other.entries_;
+    this->used_ = other.used_;
+    this->fix();
+  }
+  return *this;
+}
+
+//! a short string is stored inside std::string => pointers are fixed
+inline FlatEnvironment::FlatEnvironment(FlatEnvironment&& other)
+    : data_{std::move(other.data_)},
+      entries_{std::move(other.entries_)},
+      used_{other.used_} {
+  this->fix();
+  other.data_.clear();
+  other.entries_.clear();
+  other.used_ = 0;
+  other.fix();
+}
+
+inline FlatEnvironment& FlatEnvironment::operator =(FlatEnvironment&& other) {
+  if (this != &other) {
+    this->data_ = std::move(other.data_);
+    this->entries_ = std::move(other.entries_);
+    this->used_ = other.used_;
+    this->fix();
+    other.data_.clear();
+    other.entries_.clear();
+    other.used_ = 0;
+    other.fix();
+  }
+  return *this;
+}
+
+inline std::optional<std::string_view> FlatEnvironment::find(
+    std::string_view key
+) const {
+  const auto found = this->lower_bound(key);
+  if (found == this->entries_.end() || this->key(*found) != key) {
+    return {};
+  }
+  return std::string_view{this->data_.data() + found->offset}
+      .substr(found->key_size + 1);
+}
+
+inline void FlatEnvironment::set(
+    std::string_view key,
+    std::string_view value
+) {
+  const auto found = this->lower_bound(key);
+  const auto index = found - this->entries_.begin();
+  const auto entry = this->append(key, value);
+  if (found != this->entries_.end() && this->key(*found) == key) {
+    const auto old = std::string_view{this->data_.data() + found->offset};
+    this->used_ -= old.size() + 1;
+    this->entries_[index] = entry;
+  } else {
+    this->entries_.insert(this->entries_.begin() + index, entry);
+  }
+  this->fix();
+}
+
+inline void FlatEnvironment::unset(std::string_view key) {
+  const auto found = this->lower_bound(key);
+  if (found == this->entries_.end() || this->key(*found) != key) {
+    return;
+  }
+  const auto old = std::string_view{this->data_.data() + found->offset};
+  this->used_ -= old.size() + 1;
+  this->entries_.erase(found);
+  this->fix();
+}
+
+inline std::size_t FlatEnvironment::size() const {
+  return this->entries_.size();
+}
+
+inline char* const* FlatEnvironment::envp() const {
+  return this->envp_.data();
+}
+
+inline EnvironmentView FlatEnvironment::view() const {
+  return EnvironmentView::of(this->envp_.data());
+}
+
+inline std::string_view FlatEnvironment::key(const Entry& entry) const {
+  return std::string_view{this->data_}.substr(entry.offset, entry.key_size);
+}
+
+inline std::vector<typename FlatEnvironment::Entry>::const_iterator
+FlatEnvironment::lower_bound(std::string_view key) const {
+  return std::lower_bound(
+      this->entries_.begin(),
+      this->entries_.end(),
+      key,
+      [this](const Entry& lhs, const std::string_view& rhs) {
+        return this->key(lhs) < rhs;
+      }
+  );
+}
+
+inline typename FlatEnvironment::Entry FlatEnvironment::append(
+    std::string_view key,
+    std::string_view value
+) {
+  const auto entry = Entry{
+    .offset = static_cast<std::uint32_t>(this->data_.size()),
+    .key_size = static_cast<std::uint32_t>(key.size()),
+  };
+  this->data_.append(key).append("=").append(value);
+  this->data_.push_back('\0');
+  this->used_ += this->data_.size() - entry.offset;
+  return entry;
+}
+
+inline void FlatEnvironment::fix() {
+  if (this->used_ * 2 < this->data_.size()) {
+    auto data = std::string{};
+    data.reserve(this->used_);
+    for (auto& entry : this->entries_) {
+      const auto string = std::string_view{this->data_.data() + entry.offset};
+      entry.offset = static_cast<std::uint32_t>(data.size());
+      data.append(string);
+      data.push_back('\0');
+    }
+    this->data_ = std::move(data);
+  }
+  //! only pointers are recomputed, strings are not formatted
+  this->envp_.resize(this->entries_.size() + 1);
+  for (auto i = 0u; i < this->entries_.size(); i++) {
+    this->envp_[i] = this->data_.data() + this->entries_[i].offset;
+  }
+  this->envp_.back() = nullptr;
+}
+
+} /// namespace cu0
+
+#endif /// CU0_FLAT_ENVIRONMENT_HH__
@@ -1,6 +1,7 @@
 #ifndef CU0_PLATFORM_HXX__
 #define CU0_PLATFORM_HXX__
 
+#include <cu0/platform/cpu_topology.hh>
 #include <cu0/platform/not_an_x.hh>
 
 #endif /// CU0_PLATFORM_HXX__
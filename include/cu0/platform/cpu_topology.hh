@@ -0,0 +1,486 @@
+#ifndef CU0_CPU_TOPOLOGY_HH__
+#define CU0_CPU_TOPOLOGY_HH__
+
+#if !__has_include(<sched.h>)
+#warning <sched.h> is not found => \
+    cu0::CpuTopology::set_of(const std::vector<std::size_t>&) will not be \
+    supported
+#warning <sched.h> is not found => \
+    cu0::CpuTopology::spread(const std::size_t&) will not be supported
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+#if __has_include(<sched.h>)
+#include <sched.h>
+#endif
+
+namespace cu0 {
+
+/*!
+ * @brief The CpuTopology struct represents online cpus grouped by physical
+ *     cores, last level caches and NUMA nodes as reported by sysfs
+ * @note a group is a list of cpu ids in ascending order, groups are indexed
+ *     in the order of their first cpus
+ * @note cpus of one core are SMT siblings (hyperthreads) sharing execution
+ *     units => latency-critical strands are better pinned to different
+ *     cores @see spread()
+ */
+struct CpuTopology {
+public:
+  /*!
+   * @brief enum of possible errors for read() function
+   */
+  enum struct ReadError {
+    INVAL = EINVAL, //! list of online cpus is malformed
+    NOENT = ENOENT, //! list of online cpus is not found
+  };
+  //! online cpu
+  struct Cpu {
+    //! id of the cpu as used by the kernel
+    std::size_t id;
+    //! index of the physical core of the cpu @see cores()
+    std::size_t core;
+    //! index of the last level cache of the cpu @see caches()
+    std::size_t cache;
+    //! index of the NUMA node of the cpu @see nodes()
+    std::size_t node;
+  };
+  /*!
+   * @brief reads the topology of online cpus
+   * @note missing files of a cpu are not reported as errors:
+   *     if no SMT siblings are found => the cpu is a core of its own
+   *     if no cache is found => the cpu shares the cache with all the cpus
+   *     if no NUMA node is found => the cpu belongs to the first node
+   * @param directory is the sysfs directory of cpus
+   * @return
+   *     if no error was reported => topology
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<CpuTopology, ReadError> read(
+      const std::filesystem::path& directory = "/sys/devices/system/cpu"
+  );
+#if __has_include(<sched.h>)
+  /*!
+   * @brief creates a cpu set of the specified cpus
+   * @note ids which do not fit into cpu_set_t are ignored
+   * @param ids are ids of the cpus, e.g. one of cores() to pin to a core
+   * @return cpu set @see Strand::affinity(const cpu_set_t&)
+   */
+  [[nodiscard]]
+  static cpu_set_t set_of(const std::vector<std::size_t>& ids);
+#endif
+  /*!
+   * @brief accesses online cpus
+   * @return cpus in ascending order of ids as a const reference
+   */
+  [[nodiscard]]
+  const std::vector<Cpu>& cpus() const;
+  /*!
+   * @brief accesses physical cores
+   * @return ids of the cpus of each core as a const reference
+   */
+  [[nodiscard]]
+  const std::vector<std::vector<std::size_t>>& cores() const;
+  /*!
+   * @brief accesses last level caches
+   * @return ids of the cpus sharing each cache as a const reference
+   */
+  [[nodiscard]]
+  const std::vector<std::vector<std::size_t>>& caches() const;
+  /*!
+   * @brief accesses NUMA nodes
+   * @return ids of the cpus of each node as a const reference
+   */
+  [[nodiscard]]
+  const std::vector<std::vector<std::size_t>>& nodes() const;
+#if __has_include(<sched.h>)
+  /*!
+   * @brief spreads the specified number of strands over the cpus
+   * @note first SMT siblings of all the cores are used before second ones,
+   *     consecutive strands are placed on different last level caches
+   *     if possible
+   * @note if count exceeds the number of cpus => the cpus are reused in
+   *     the same order
+   * @note only the cpus the calling process may run on are used
+   *     @see ::sched_getaffinity()
+   *     if it fails => all the cpus are used
+   * @param count is the number of strands, e.g. StrandPool::Options::size
+   * @return set of one cpu per strand @see StrandPool::Options::affinities
+   */
+  [[nodiscard]]
+  std::vector<cpu_set_t> spread(const std::size_t& count) const;
+  /*!
+   * @brief spreads the specified number of strands over the allowed cpus
+   *     @see spread(const std::size_t&)
+   * @param count is the number of strands, e.g. StrandPool::Options::size
+   * @param allowed is the set of cpus which may be used
+   * @return
+   *     if any allowed cpu is in the topology => set of one cpu per strand
+   *     else => empty vector
+   */
+  [[nodiscard]]
+  std::vector<cpu_set_t> spread(
+      const std::size_t& count,
+      const cpu_set_t& allowed
+  ) const;
+#endif
+protected:
+  /*!
+   * @brief reads a cpu list file, e.g. "0-3,8-11"
+   * @param file is the path of the file
+   * @return
+   *     if the file is read and well-formed => ids of the list
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static std::optional<std::vector<std::size_t>> list_of(
+      const std::filesystem::path& file
+  );
+  /*!
+   * @brief reads the first line of a file
+   * @param file is the path of the file
+   * @return
+   *     if the file is read => first line of the file
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static std::optional<std::string> line_of(
+      const std::filesystem::path& file
+  );
+  /*!
+   * @brief finds the key of the last level cache of a cpu
+   * @param directory is the sysfs directory of the cpu
+   * @return
+   *     if a data or unified cache is found => lowest id sharing the cache
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static std::optional<std::size_t> cache_of(
+      const std::filesystem::path& directory
+  );
+  /*!
+   * @brief finds the NUMA node of a cpu
+   * @param directory is the sysfs directory of the cpu
+   * @return
+   *     if a node link is found => id of the node
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static std::optional<std::size_t> node_of(
+      const std::filesystem::path& directory
+  );
+  /*!
+   * @brief adds a cpu to the group of a key
+   * @param keys are keys of the groups in the order of the groups
+   * @param groups are the groups
+   * @param key is the key of the group of the cpu
+   * @param id is the id of the cpu
+   * @return index of the group
+   */
+  static std::size_t group(
+      std::vector<std::size_t>& keys,
+      std::vector<std::vector<std::size_t>>& groups,
+      const std::size_t& key,
+      const std::size_t& id
+  );
+  /*!
+   * @brief constructs an instance without cpus
+   */
+  CpuTopology() = default;
+  //! online cpus
+  std::vector<Cpu> cpus_{};
+  //! cpus of each physical core
+  std::vector<std::vector<std::size_t>> cores_{};
+  //! cpus of each last level cache
+  std::vector<std::vector<std::size_t>> caches_{};
+  //! cpus of each NUMA node
+  std::vector<std::vector<std::size_t>> nodes_{};
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline std::variant<CpuTopology, typename CpuTopology::ReadError>
+CpuTopology::read(
+    const std::filesystem::path& directory
+) {
+  auto error = std::error_code{};
+  if (!std::filesystem::exists(directory / "online", error)) {
+    return ReadError::NOENT;
+  }
+  const auto online = CpuTopology::list_of(directory / "online");
+  if (!online.has_value() || online.value().empty()) {
+    return ReadError::INVAL;
+  }
+  auto ret = CpuTopology{};
+  auto core_keys = std::vector<std::size_t>{};
+  auto cache_keys = std::vector<std::size_t>{};
+  auto node_keys = std::vector<std::size_t>{};
+  for (const auto& id : online.value()) {
+    const auto cpu = directory / ("cpu" + std::to_string(id));
+    //! core_cpus_list replaced thread_siblings_list in newer kernels
+    auto siblings = CpuTopology::list_of(cpu / "topology/core_cpus_list");
+    if (!siblings.has_value() || siblings.value().empty()) {
+      siblings = CpuTopology::list_of(cpu / "topology/thread_siblings_list");
+    }
+    const auto core = siblings.has_value() && !siblings.value().empty() ?
+        siblings.value().front() :
+        id;
+    ret.cpus_.push_back(Cpu{
+      .id = id,
+      .core = CpuTopology::group(core_keys, ret.cores_, core, id),
+      .cache = CpuTopology::group(
+          cache_keys,
+          ret.caches_,
+          CpuTopology::cache_of(cpu).value_or(0),
+          id
+      ),
+      .node = CpuTopology::group(
+          node_keys,
+          ret.nodes_,
+          CpuTopology::node_of(cpu).value_or(0),
+          id
+      ),
+    });
+  }
+  return ret;
+}
+
+#if __has_include(<sched.h>)
+inline cpu_set_t CpuTopology::set_of(const std::vector<std::size_t>& ids) {
+  auto ret = cpu_set_t{};
+  CPU_ZERO(&ret);
+  for (const auto& id : ids) {
+    if (id < CPU_SETSIZE) {
+      CPU_SET(id, &ret);
+    }
+  }
+  return ret;
+}
+#endif
+
+inline const std::vector<typename CpuTopology::Cpu>& CpuTopology::cpus() const {
+  return this->cpus_;
+}
+
+inline const std::vector<std::vector<std::size_t>>& CpuTopology::cores() const {
+  return this->cores_;
+}
+
+inline const std::vector<std::vector<std::size_t>>&
+CpuTopology::caches() const {
+  return this->caches_;
+}
+
+inline const std::vector<std::vector<std::size_t>>& CpuTopology::nodes() const {
+  return this->nodes_;
+}
+
+#if __has_include(<sched.h>)
+inline std::vector<cpu_set_t> CpuTopology::spread(
+    const std::size_t& count
+) const {
+  auto allowed = cpu_set_t{};
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    CPU_ZERO(&allowed);
+    for (const auto& cpu : this->cpus_) {
+      if (cpu.id < CPU_SETSIZE) {
+        CPU_SET(cpu.id, &allowed);
+      }
+    }
+  }
+  return this->spread(count, allowed);
+}
+
+inline std::vector<cpu_set_t> CpuTopology::spread(
+    const std::size_t& count,
+    const cpu_set_t& allowed
+) const {
+  //! cores of each cache in the order of the cores
+  auto cores = std::vector<std::vector<std::size_t>>(this->caches_.size());
+  auto threads = std::size_t{0};
+  for (const auto& cpu : this->cpus_) {
+    const auto& core = this->cores_[cpu.core];
+    //! a core is added once: by its first cpu
+    if (core.front() == cpu.id) {
+      cores[cpu.cache].push_back(cpu.core);
+      threads = std::max(threads, core.size());
+    }
+  }
+  auto order = std::vector<std::size_t>{};
+  order.reserve(this->cpus_.size());
+  //! n-th siblings of all the cores, caches are interleaved
+  for (auto thread = 0u; thread < threads; thread++) {
+    for (auto position = 0u;; position++) {
+      auto placed = false;
+      for (const auto& cache : cores) {
+        if (position >= cache.size()) {
+          continue;
+        }
+        placed = true;
+        const auto& core = this->cores_[cache[position]];
+        //! a cpu of a container, a cpuset or taskset may be not allowed
+        if (
+            thread < core.size() &&
+            core[thread] < CPU_SETSIZE &&
+            CPU_ISSET(core[thread], &allowed)
+        ) {
+          order.push_back(core[thread]);
+        }
+      }
+      if (!placed) {
+        break;
+      }
+    }
+  }
+  auto ret = std::vector<cpu_set_t>{};
+  ret.reserve(count);
+  for (auto i = 0u; i < count && !order.empty(); i++) {
+    ret.push_back(CpuTopology::set_of({ order[i % order.size()], }));
+  }
+  return ret;
+}
+#endif
+
+inline std::optional<std::vector<std::size_t>> CpuTopology::list_of(
+    const std::filesystem::path& file
+) {
+  const auto line = CpuTopology::line_of(file);
+  if (!line.has_value()) {
+    return {};
+  }
+  auto ret = std::vector<std::size_t>{};
+  //! format: comma separated ids and inclusive ranges, e.g. "0-3,8-11"
+  auto rest = std::string_view{line.value()};
+  while (!rest.empty()) {
+    const auto comma = rest.find(',');
+    const auto item = rest.substr(0, comma);
+    rest = comma == std::string_view::npos ?
+        std::string_view{} :
+        rest.substr(comma + 1);
+    const auto* const end = item.data() + item.size();
+    auto first = std::size_t{0};
+    auto parsed = std::from_chars(item.data(), end, first);
+    if (parsed.ec != std::errc{}) {
+      return {};
+    }
+    auto last = first;
+    if (parsed.ptr != end && *parsed.ptr == '-') {
+      parsed = std::from_chars(parsed.ptr + 1, end, last);
+      if (parsed.ec != std::errc{} || last < first) {
+        return {};
+      }
+    }
+    if (parsed.ptr != end) {
+      return {};
+    }
+    for (auto id = first; id <= last; id++) {
+      ret.push_back(id);
+    }
+  }
+  return ret;
+}
+
+inline std::optional<std::string> CpuTopology::line_of(
+    const std::filesystem::path& file
+) {
+  auto stream = std::ifstream{file};
+  if (!stream.is_open()) {
+    return {};
+  }
+  auto ret = std::string{};
+  //! an empty file is an empty line
+  std::getline(stream, ret);
+  return ret;
+}
+
+inline std::optional<std::size_t> CpuTopology::cache_of(
+    const std::filesystem::path& directory
+) {
+  auto error = std::error_code{};
+  auto caches = std::filesystem::directory_iterator{directory / "cache", error};
+  if (error) {
+    return {};
+  }
+  auto ret = std::optional<std::size_t>{};
+  auto level = std::size_t{0};
+  //! a cache directory: index<N>/{level,type,shared_cpu_list}
+  for (const auto& entry : caches) {
+    if (!entry.path().filename().string().starts_with("index")) {
+      continue;
+    }
+    const auto type = CpuTopology::line_of(entry.path() / "type");
+    const auto index_level = CpuTopology::list_of(entry.path() / "level");
+    const auto shared = CpuTopology::list_of(entry.path() / "shared_cpu_list");
+    if (
+        !type.has_value() || type.value() == "Instruction" ||
+        !index_level.has_value() || index_level.value().size() != 1 ||
+        !shared.has_value() || shared.value().empty() ||
+        index_level.value().front() <= level
+    ) {
+      continue;
+    }
+    level = index_level.value().front();
+    ret = shared.value().front();
+  }
+  return ret;
+}
+
+inline std::optional<std::size_t> CpuTopology::node_of(
+    const std::filesystem::path& directory
+) {
+  auto error = std::error_code{};
+  auto entries = std::filesystem::directory_iterator{directory, error};
+  if (error) {
+    return {};
+  }
+  //! a cpu directory contains a node<N> link to its NUMA node
+  for (const auto& entry : entries) {
+    const auto name = entry.path().filename().string();
+    if (!name.starts_with("node") || name.size() == 4) {
+      continue;
+    }
+    auto ret = std::size_t{0};
+    const auto* const end = name.data() + name.size();
+    const auto [ptr, ec] = std::from_chars(name.data() + 4, end, ret);
+    if (ec == std::errc{} && ptr == end) {
+      return ret;
+    }
+  }
+  return {};
+}
+
+inline std::size_t CpuTopology::group(
+    std::vector<std::size_t>& keys,
+    std::vector<std::vector<std::size_t>>& groups,
+    const std::size_t& key,
+    const std::size_t& id
+) {
+  const auto found = std::find(keys.begin(), keys.end(), key);
+  const auto ret = static_cast<std::size_t>(found - keys.begin());
+  if (found == keys.end()) {
+    keys.push_back(key);
+    groups.emplace_back();
+  }
+  groups[ret].push_back(id);
+  return ret;
+}
+
+} /// namespace cu0
+
+#endif /// CU0_CPU_TOPOLOGY_HH__
@@ -1,8 +1,18 @@
 #ifndef CU0_PROC_HXX__
 #define CU0_PROC_HXX__
 
+#include <cu0/proc/cgroup.hh>
+#include <cu0/proc/channel.hh>
 #include <cu0/proc/executable.hh>
+#include <cu0/proc/executable_cache.hh>
+#include <cu0/proc/executable_handle.hh>
+#include <cu0/proc/executable_index.hh>
+#include <cu0/proc/fork_server.hh>
 #include <cu0/proc/process.hh>
+#include <cu0/proc/reaper.hh>
+#include <cu0/proc/spawn_options.hh>
 #include <cu0/proc/strand.hh>
+#include <cu0/proc/strand_pool.hh>
+#include <cu0/proc/task.hh>
 
 #endif /// CU0_PROC_HXX__
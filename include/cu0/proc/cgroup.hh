@@ -0,0 +1,330 @@
+#ifndef CU0_CGROUP_HH__
+#define CU0_CGROUP_HH__
+
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::Cgroup will not be supported
+#endif
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+    cu0::Cgroup will not be supported
+#endif
+#if !__has_include(<unistd.h>)
+#warning <unistd.h> is not found => \
+    cu0::Cgroup will not be supported
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <variant>
+
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
+#if __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace cu0 {
+
+#if \
+    __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief The Cgroup struct provides a way to create a cgroup v2 and to limit
+ *     resources of processes placed into it
+ * @note processes are placed into a cgroup when they are created
+ *     @see SpawnOptions::cgroup
+ * @note memory and cpu controllers need to be enabled in cgroup.subtree_control
+ *     of the parent cgroup for memory_max() and cpu_max() to succeed
+ */
+struct Cgroup {
+public:
+  /*!
+   * @brief enum of possible errors for create() function
+   */
+  enum struct CreateError {
+    ACCES = EACCES, //! @see EACCES
+    EXIST = EEXIST, //! @see EEXIST
+    NOENT = ENOENT, //! @see ENOENT
+    NOSPC = ENOSPC, //! @see ENOSPC
+    PERM = EPERM, //! @see EPERM
+    ROFS = EROFS, //! @see EROFS
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    NOMEM = ENOMEM, //! @see ENOMEM
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::mkdir() and ::open()
+  };
+  /*!
+   * @brief enum of possible errors for memory_max() and cpu_max() functions
+   */
+  enum struct WriteError {
+    ACCES = EACCES, //! @see EACCES
+    INVAL = EINVAL, //! @see EINVAL
+    NOENT = ENOENT, //! @see ENOENT
+    PERM = EPERM, //! @see EPERM
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::openat() and ::write()
+  };
+  /*!
+   * @brief finds the cgroup v2 of the current process
+   * @return
+   *     if a cgroup v2 hierarchy is mounted => path of the cgroup
+   *     else => empty optional
+   */
+  [[nodiscard]]
+  static std::optional<std::filesystem::path> current();
+  /*!
+   * @brief creates a cgroup
+   * @param path is the path of the cgroup to be created,
+   *     e.g. a child of Cgroup::current()
+   * @return
+   *     if no error was reported => created cgroup
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<Cgroup, CreateError> create(
+      const std::filesystem::path& path
+  );
+  /*!
+   * @brief destructs an instance
+   * @note the cgroup is removed if there are no processes in it
+   */
+  virtual ~Cgroup();
+  constexpr Cgroup(const Cgroup& other) = delete;
+  constexpr Cgroup& operator =(const Cgroup& other) = delete;
+  /*!
+   * @brief moves cgroup resources to this cgroup
+   * @param other is the cgroup for which resources need to be moved
+   */
+  Cgroup(Cgroup&& other);
+  /*!
+   * @brief moves cgroup resources to this cgroup
+   * @param other is the cgroup for which resources need to be moved
+   * @return this cgroup as a mutable reference
+   */
+  Cgroup& operator =(Cgroup&& other);
+  /*!
+   * @brief accesses the file descriptor of the cgroup directory
+   * @return file descriptor as a const reference
+   */
+  [[nodiscard]]
+  constexpr const int& fd() const;
+  /*!
+   * @brief accesses the path of the cgroup
+   * @return path as a const reference
+   */
+  [[nodiscard]]
+  constexpr const std::filesystem::path& path() const;
+  /*!
+   * @brief limits memory usage of the processes in the cgroup
+   * @param bytes is the limit in bytes
+   *     if empty => no limit
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, WriteError> memory_max(
+      const std::optional<std::uint64_t>& bytes
+  ) const;
+  /*!
+   * @brief limits cpu time of the processes in the cgroup
+   * @param quota is the cpu time available in each period
+   *     if empty => no limit
+   * @param period is the length of a period
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, WriteError> cpu_max(
+      const std::optional<std::chrono::microseconds>& quota,
+      const std::chrono::microseconds& period = std::chrono::milliseconds{100}
+  ) const;
+protected:
+  /*!
+   * @brief writes the specified value into the specified file of the cgroup
+   * @param file is the name of a file in the cgroup directory
+   * @param value is the value to write
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, WriteError> write(
+      const char* file,
+      const std::string& value
+  ) const;
+  /*!
+   * @brief constructs an instance with default values
+   */
+  Cgroup() = default;
+  /*!
+   * @brief swaps two cgroups
+   * @param other is the cgroup to swap this cgroup with
+   */
+  void swap(Cgroup&& other);
+  //! file descriptor of the cgroup directory
+  int fd_ = -1;
+  //! path of the cgroup
+  std::filesystem::path path_{};
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if \
+    __has_include(<fcntl.h>) && \
+    __has_include(<sys/stat.h>) && \
+    __has_include(<unistd.h>)
+inline std::optional<std::filesystem::path> Cgroup::current() {
+  //! a line of /proc/self/mounts:
+  //!     device mount_point type options dump pass
+  auto mounts = std::ifstream{"/proc/self/mounts"};
+  auto mount_point = std::optional<std::filesystem::path>{};
+  for (auto line = std::string{}; std::getline(mounts, line);) {
+    auto stream = std::istringstream{line};
+    auto device = std::string{};
+    auto point = std::string{};
+    auto type = std::string{};
+    stream >> device >> point >> type;
+    if (type == "cgroup2") {
+      mount_point = point;
+      break;
+    }
+  }
+  if (!mount_point.has_value()) {
+    return {};
+  }
+  //! the line of the cgroup v2 hierarchy in /proc/self/cgroup:
+  //!     0::/relative/path
+  auto cgroups = std::ifstream{"/proc/self/cgroup"};
+  for (auto line = std::string{}; std::getline(cgroups, line);) {
+    if (line.starts_with("0::/")) {
+      const auto relative = line.substr(4);
+      if (relative.empty()) { //! the root cgroup
+        return mount_point;
+      }
+      return mount_point.value() / relative;
+    }
+  }
+  return {};
+}
+
+inline std::variant<Cgroup, typename Cgroup::CreateError> Cgroup::create(
+    const std::filesystem::path& path
+) {
+  if (::mkdir(path.c_str(), 0755) != 0) {
+    return static_cast<CreateError>(errno);
+  }
+  //! the directory is opened to be used by ::openat() in a forked process
+  const auto fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    const auto ret = static_cast<CreateError>(errno);
+    //! do not handle errors if any
+    ::rmdir(path.c_str());
+    return ret;
+  }
+  auto cgroup = Cgroup{};
+  cgroup.fd_ = fd;
+  cgroup.path_ = path;
+  return cgroup;
+}
+
+inline Cgroup::~Cgroup() {
+  if (this->fd_ < 0) {
+    return;
+  }
+  //! do not handle errors if any
+  ::close(this->fd_);
+  ::rmdir(this->path_.c_str());
+}
+
+inline Cgroup::Cgroup(Cgroup&& other) {
+  this->swap(std::move(other));
+}
+
+inline Cgroup& Cgroup::operator =(Cgroup&& other) {
+  if (this != &other) {
+    this->swap(std::move(other));
+  }
+  return *this;
+}
+
+constexpr const int& Cgroup::fd() const {
+  return this->fd_;
+}
+
+constexpr const std::filesystem::path& Cgroup::path() const {
+  return this->path_;
+}
+
+inline std::variant<std::monostate, typename Cgroup::WriteError>
+Cgroup::memory_max(
+    const std::optional<std::uint64_t>& bytes
+) const {
+  return this->write(
+      "memory.max",
+      bytes.has_value() ? std::to_string(bytes.value()) : "max"
+  );
+}
+
+inline std::variant<std::monostate, typename Cgroup::WriteError>
+Cgroup::cpu_max(
+    const std::optional<std::chrono::microseconds>& quota,
+    const std::chrono::microseconds& period
+) const {
+  //! format: "$MAX $PERIOD"
+  return this->write(
+      "cpu.max",
+      (quota.has_value() ? std::to_string(quota.value().count()) : "max") +
+          " " + std::to_string(period.count())
+  );
+}
+
+inline std::variant<std::monostate, typename Cgroup::WriteError>
+Cgroup::write(
+    const char* file,
+    const std::string& value
+) const {
+  const auto fd = ::openat(this->fd_, file, O_WRONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return static_cast<WriteError>(errno);
+  }
+  //! cgroup files are written at once
+  const auto written = ::write(fd, value.data(), value.size());
+  const auto error = errno;
+  //! do not handle errors if any
+  ::close(fd);
+  if (written < 0) {
+    return static_cast<WriteError>(error);
+  }
+  return std::monostate{};
+}
+
+inline void Cgroup::swap(Cgroup&& other) {
+  std::swap(this->fd_, other.fd_);
+  std::swap(this->path_, other.path_);
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_CGROUP_HH__
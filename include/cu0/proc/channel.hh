@@ -0,0 +1,667 @@
+#ifndef CU0_CHANNEL_HH__
+#define CU0_CHANNEL_HH__
+
+#if !__has_include(<linux/futex.h>)
+#warning <linux/futex.h> is not found => \
+    cu0::Channel will not be supported
+#endif
+#if !__has_include(<sys/mman.h>)
+#warning <sys/mman.h> is not found => \
+    cu0::Channel will not be supported
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::Channel will not be supported
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <utility>
+#include <variant>
+
+#if __has_include(<linux/futex.h>)
+#include <linux/futex.h>
+#endif
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+#if __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#endif
+#if __has_include(<sys/syscall.h>)
+#include <sys/syscall.h>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace cu0 {
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+/*!
+ * @brief The Channel struct provides a way to exchange data between a parent
+ *     process and a child process through shared memory
+ * @note a channel consists of two single-producer single-consumer ring buffers
+ *     one for each direction, which are stored in a memory file
+ * @note the parent creates a channel @see Channel::create() and passes it
+ *     to a child @see Process::create(const Executable&, const Channel&)
+ *     the child attaches to the channel @see Channel::attach()
+ * @note each side of a channel needs to be used by one thread at a time
+ */
+struct Channel {
+public:
+  /*!
+   * @brief enum of possible errors for create() function
+   */
+  enum struct CreateError {
+    INVAL = EINVAL, //! @see EINVAL
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    NOMEM = ENOMEM, //! @see ENOMEM
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::memfd_create() and ::mmap()
+  };
+  /*!
+   * @brief enum of possible errors for attach() function
+   */
+  enum struct AttachError {
+    BADF = EBADF, //! @see EBADF
+    INVAL = EINVAL, //! @see EINVAL
+    NOMEM = ENOMEM, //! @see ENOMEM
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::fstat() and ::mmap()
+  };
+  /*!
+   * @brief creates a channel, i.e. the parent side of a channel
+   * @param capacity is the minimal capacity of each ring buffer in bytes
+   * @note capacity is rounded up to a power of two
+   * @return
+   *     if no error was reported => created channel
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<Channel, CreateError> create(
+      const std::size_t& capacity
+  );
+  /*!
+   * @brief attaches to a channel, i.e. creates the child side of a channel
+   * @param fd is the file descriptor of the channel inherited from the parent
+   *     @see Channel::fd()
+   * @return
+   *     if no error was reported => attached channel
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<Channel, AttachError> attach(const int& fd);
+  /*!
+   * @brief destructs an instance
+   * @note the channel is closed @see Channel::close()
+   */
+  virtual ~Channel();
+  constexpr Channel(const Channel& other) = delete;
+  constexpr Channel& operator =(const Channel& other) = delete;
+  /*!
+   * @brief moves channel resources to this channel
+   * @param other is the channel for which resources need to be moved
+   */
+  constexpr Channel(Channel&& other);
+  /*!
+   * @brief moves channel resources to this channel
+   * @param other is the channel for which resources need to be moved
+   * @return this channel as a mutable reference
+   */
+  constexpr Channel& operator =(Channel&& other);
+  /*!
+   * @brief accesses the file descriptor of the channel
+   * @return file descriptor as a const reference
+   */
+  [[nodiscard]]
+  constexpr const int& fd() const;
+  /*!
+   * @brief accesses the capacity of each ring buffer
+   * @note the capacity is read once by create() or attach() =>
+   *     the other side can not change it
+   * @return capacity in bytes
+   */
+  [[nodiscard]]
+  std::size_t capacity() const;
+  /*!
+   * @brief writes the specified data to the other side of the channel
+   * @note blocks until all the data are written or the channel is closed
+   * @note if the indices of the ring buffer are corrupted by the other side
+   *     => the channel is closed
+   * @param data is the data to write
+   * @param size is the size of the data in bytes
+   * @return number of bytes written
+   */
+  std::size_t write(const void* data, const std::size_t& size) const;
+  /*!
+   * @brief reads data written by the other side of the channel
+   * @note blocks until some data are available or the channel is closed
+   * @note if the indices of the ring buffer are corrupted by the other side
+   *     => the channel is closed
+   * @param data is the buffer to read into
+   * @param size is the size of the buffer in bytes
+   * @return
+   *     if the channel is closed and no data are left => 0
+   *     else => number of bytes read
+   */
+  std::size_t read(void* data, const std::size_t& size) const;
+  /*!
+   * @brief closes the channel
+   * @note the other side reads the data which have already been written and
+   *     then reads 0 bytes, writes of the other side are not blocked anymore
+   */
+  void close() const;
+protected:
+  //! single-producer single-consumer ring buffer control data
+  struct Ring {
+    //! number of bytes written since creation, modified by the producer
+    alignas(64) std::atomic<std::uint64_t> head;
+    //! number of bytes read since creation, modified by the consumer
+    alignas(64) std::atomic<std::uint64_t> tail;
+    //! futex word which is modified when data become available
+    alignas(64) std::atomic<std::uint32_t> readable;
+    //! non-zero if the consumer waits for data
+    std::atomic<std::uint32_t> consumer_waiting;
+    //! futex word which is modified when space becomes available
+    alignas(64) std::atomic<std::uint32_t> writable;
+    //! non-zero if the producer waits for space
+    std::atomic<std::uint32_t> producer_waiting;
+    //! non-zero if the channel is closed
+    std::atomic<std::uint32_t> closed;
+  };
+  //! control data stored at the beginning of a memory file
+  struct Header {
+    //! capacity of each ring buffer in bytes
+    std::uint64_t capacity;
+    //! ring buffer from the parent to the child
+    Ring down;
+    //! ring buffer from the child to the parent
+    Ring up;
+  };
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+  static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+  //! number of checks before waiting on a futex on multiprocessor systems
+  static constexpr auto SPIN_COUNT = 256;
+  /*!
+   * @brief calculates the offset of ring buffer data in a memory file
+   * @return offset in bytes
+   */
+  static std::size_t data_offset();
+  /*!
+   * @brief maps the memory file with the specified size
+   * @param fd is the file descriptor of the memory file
+   * @param size is the size of the memory file in bytes
+   * @return mapped memory or MAP_FAILED
+   */
+  static void* map(const int& fd, const std::size_t& size);
+  /*!
+   * @brief waits until the specified predicate is satisfied
+   * @param word is the futex word to wait on
+   * @param waiting is the flag announcing the wait
+   * @param ready is the predicate
+   */
+  template <class Predicate>
+  static void wait(
+      std::atomic<std::uint32_t>& word,
+      std::atomic<std::uint32_t>& waiting,
+      const Predicate& ready
+  );
+  /*!
+   * @brief wakes the other side if it waits
+   * @param word is the futex word to wake
+   * @param waiting is the flag announcing the wait
+   */
+  static void notify(
+      std::atomic<std::uint32_t>& word,
+      std::atomic<std::uint32_t>& waiting
+  );
+  /*!
+   * @brief wakes the other side unconditionally
+   * @param word is the futex word to wake
+   */
+  static void wake(std::atomic<std::uint32_t>& word);
+  /*!
+   * @brief accesses the control data
+   * @return header as a mutable reference
+   */
+  Header& header() const;
+  /*!
+   * @brief accesses the ring buffer used for writing by this side
+   * @return ring buffer control data as a mutable reference
+   */
+  Ring& out() const;
+  /*!
+   * @brief accesses the ring buffer used for reading by this side
+   * @return ring buffer control data as a mutable reference
+   */
+  Ring& in() const;
+  /*!
+   * @brief accesses the data of the ring buffer used for writing by this side
+   * @return pointer to the data
+   */
+  char* out_data() const;
+  /*!
+   * @brief accesses the data of the ring buffer used for reading by this side
+   * @return pointer to the data
+   */
+  char* in_data() const;
+  /*!
+   * @brief constructs an instance with default values
+   */
+  constexpr Channel() = default;
+  /*!
+   * @brief swaps two channels
+   * @param other is the channel to swap this channel with
+   */
+  constexpr void swap(Channel&& other);
+  //! file descriptor of the memory file
+  int fd_ = -1;
+  //! mapped memory file
+  void* memory_ = nullptr;
+  //! size of the mapped memory file in bytes
+  std::size_t size_ = 0;
+  //! capacity of each ring buffer in bytes
+  //! @note not read from the header after create() or attach() =>
+  //!     the other side can not make it inconsistent with size_
+  std::size_t capacity_ = 0;
+  //! true if this is the parent side of the channel
+  bool parent_ = false;
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::variant<Channel, typename Channel::CreateError> Channel::create(
+    const std::size_t& capacity
+) {
+  if (capacity == 0 || capacity > (std::size_t{1} << 40)) {
+    return CreateError::INVAL;
+  }
+  auto rounded = std::size_t{1};
+  while (rounded < capacity) {
+    rounded <<= 1;
+  }
+  const auto fd = ::memfd_create("cu0::Channel", MFD_CLOEXEC);
+  if (fd < 0) {
+    return static_cast<CreateError>(errno);
+  }
+  const auto size = Channel::data_offset() + 2 * rounded;
+  if (::ftruncate(fd, size) != 0) {
+    const auto ret = static_cast<CreateError>(errno);
+    //! do not handle errors if any
+    ::close(fd);
+    return ret;
+  }
+  auto* memory = Channel::map(fd, size);
+  if (memory == MAP_FAILED) {
+    const auto ret = static_cast<CreateError>(errno);
+    //! do not handle errors if any
+    ::close(fd);
+    return ret;
+  }
+  auto* header = new (memory) Header{};
+  header->capacity = rounded;
+  auto ret = Channel{};
+  ret.fd_ = fd;
+  ret.memory_ = memory;
+  ret.size_ = size;
+  ret.capacity_ = rounded;
+  ret.parent_ = true;
+  return ret;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::variant<Channel, typename Channel::AttachError> Channel::attach(
+    const int& fd
+) {
+  struct ::stat status;
+  if (::fstat(fd, &status) != 0) {
+    return static_cast<AttachError>(errno);
+  }
+  const auto size = static_cast<std::size_t>(status.st_size);
+  if (size < Channel::data_offset()) {
+    return AttachError::INVAL;
+  }
+  auto* memory = Channel::map(fd, size);
+  if (memory == MAP_FAILED) {
+    return static_cast<AttachError>(errno);
+  }
+  const auto capacity = static_cast<const Header*>(memory)->capacity;
+  if (
+      capacity == 0 ||
+      (capacity & (capacity - 1)) != 0 ||
+      Channel::data_offset() + 2 * capacity != size
+  ) {
+    //! do not handle errors if any
+    ::munmap(memory, size);
+    return AttachError::INVAL;
+  }
+  auto ret = Channel{};
+  ret.fd_ = fd;
+  ret.memory_ = memory;
+  ret.size_ = size;
+  ret.capacity_ = capacity;
+  ret.parent_ = false;
+  return ret;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline Channel::~Channel() {
+  if (this->memory_ == nullptr) {
+    return;
+  }
+  this->close();
+  //! do not handle errors if any
+  ::munmap(this->memory_, this->size_);
+  ::close(this->fd_);
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+constexpr Channel::Channel(Channel&& other) {
+  this->swap(std::move(other));
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+constexpr Channel& Channel::operator =(Channel&& other) {
+  if (this != &other) {
+    this->swap(std::move(other));
+  }
+  return *this;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+constexpr const int& Channel::fd() const {
+  return this->fd_;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::size_t Channel::capacity() const {
+  return this->capacity_;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::size_t Channel::write(
+    const void* data,
+    const std::size_t& size
+) const {
+  auto& ring = this->out();
+  auto* ring_data = this->out_data();
+  const auto capacity = this->capacity();
+  const auto* bytes = static_cast<const char*>(data);
+  auto written = std::size_t{0};
+  while (written < size) {
+    const auto head = ring.head.load(std::memory_order_relaxed);
+    Channel::wait(
+        ring.writable,
+        ring.producer_waiting,
+        [&ring, &head, &capacity](){
+          //! a tail ahead of the head is seen as a full ring =>
+          //!     corrupted indices do not block
+          return
+              head - ring.tail.load() != capacity ||
+              ring.closed.load() != 0;
+        }
+    );
+    if (ring.closed.load(std::memory_order_acquire) != 0) {
+      break;
+    }
+    const auto tail = ring.tail.load(std::memory_order_acquire);
+    if (head - tail > capacity) { //! the other side is broken
+      this->close();
+      break;
+    }
+    const auto count = std::min<std::size_t>(
+        capacity - (head - tail),
+        size - written
+    );
+    const auto offset = head & (capacity - 1);
+    const auto first = std::min<std::size_t>(count, capacity - offset);
+    std::memcpy(ring_data + offset, bytes + written, first);
+    std::memcpy(ring_data, bytes + written + first, count - first);
+    ring.head.store(head + count, std::memory_order_release);
+    Channel::notify(ring.readable, ring.consumer_waiting);
+    written += count;
+  }
+  return written;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::size_t Channel::read(void* data, const std::size_t& size) const {
+  if (size == 0) {
+    return 0;
+  }
+  auto& ring = this->in();
+  const auto* ring_data = this->in_data();
+  const auto capacity = this->capacity();
+  const auto tail = ring.tail.load(std::memory_order_relaxed);
+  Channel::wait(ring.readable, ring.consumer_waiting, [&ring, &tail](){
+    return ring.head.load() != tail || ring.closed.load() != 0;
+  });
+  const auto head = ring.head.load(std::memory_order_acquire);
+  if (head - tail > capacity) { //! the other side is broken
+    this->close();
+    return 0;
+  }
+  const auto count = std::min<std::size_t>(head - tail, size);
+  const auto offset = tail & (capacity - 1);
+  const auto first = std::min<std::size_t>(count, capacity - offset);
+  auto* bytes = static_cast<char*>(data);
+  std::memcpy(bytes, ring_data + offset, first);
+  std::memcpy(bytes + first, ring_data, count - first);
+  ring.tail.store(tail + count, std::memory_order_release);
+  Channel::notify(ring.writable, ring.producer_waiting);
+  return count;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline void Channel::close() const {
+  for (auto* ring : { &this->out(), &this->in(), }) {
+    ring->closed.store(1);
+    Channel::wake(ring->readable);
+    Channel::wake(ring->writable);
+  }
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::size_t Channel::data_offset() {
+  const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGE_SIZE));
+  return (sizeof(Header) + page_size - 1) / page_size * page_size;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline void* Channel::map(const int& fd, const std::size_t& size) {
+  return ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+template <class Predicate>
+inline void Channel::wait(
+    std::atomic<std::uint32_t>& word,
+    std::atomic<std::uint32_t>& waiting,
+    const Predicate& ready
+) {
+  //! spinning only delays the other side if there is one processor
+  static const auto spin_count =
+      ::sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SPIN_COUNT : 0;
+  for (auto i = 0; i < spin_count; i++) {
+    if (ready()) {
+      return;
+    }
+  }
+  while (true) {
+    const auto value = word.load();
+    //! announce the wait before the last check =>
+    //!     the other side either sees the announcement or
+    //!     its modification is seen by the last check
+    waiting.store(1);
+    if (ready()) {
+      waiting.store(0, std::memory_order_relaxed);
+      return;
+    }
+    //! the memory file is shared between processes => no FUTEX_PRIVATE_FLAG
+    //! do not handle errors if any, the predicate is checked again
+    ::syscall(SYS_futex, &word, FUTEX_WAIT, value, NULL, NULL, 0);
+    waiting.store(0, std::memory_order_relaxed);
+  }
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline void Channel::notify(
+    std::atomic<std::uint32_t>& word,
+    std::atomic<std::uint32_t>& waiting
+) {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting.load() != 0) {
+    Channel::wake(word);
+  }
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline void Channel::wake(std::atomic<std::uint32_t>& word) {
+  word.fetch_add(1);
+  //! do not handle errors if any
+  ::syscall(SYS_futex, &word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline typename Channel::Header& Channel::header() const {
+  return *static_cast<Header*>(this->memory_);
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline typename Channel::Ring& Channel::out() const {
+  return this->parent_ ? this->header().down : this->header().up;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline typename Channel::Ring& Channel::in() const {
+  return this->parent_ ? this->header().up : this->header().down;
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline char* Channel::out_data() const {
+  return
+      static_cast<char*>(this->memory_) +
+      Channel::data_offset() +
+      (this->parent_ ? 0 : this->capacity());
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline char* Channel::in_data() const {
+  return
+      static_cast<char*>(this->memory_) +
+      Channel::data_offset() +
+      (this->parent_ ? this->capacity() : 0);
+}
+#endif
+
+#if \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+constexpr void Channel::swap(Channel&& other) {
+  std::swap(this->fd_, other.fd_);
+  std::swap(this->memory_, other.memory_);
+  std::swap(this->size_, other.size_);
+  std::swap(this->capacity_, other.capacity_);
+  std::swap(this->parent_, other.parent_);
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_CHANNEL_HH__
@@ -1,13 +1,42 @@
 #ifndef CU0_EXECUTABLE_HH__
 #define CU0_EXECUTABLE_HH__
 
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+    cu0::util::Lookup::EXISTS will scan a directory
+#warning <sys/stat.h> is not found => \
+    cu0::util::Lookup::EXECUTABLE will scan a directory
+#endif
+#if !__has_include(<dirent.h>)
+#warning <dirent.h> is not found => \
+    cu0::util::find_by(std::span<const std::string>, \
+    const std::filesystem::path&) will not be supported
+#endif
+
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#if __has_include(<dirent.h>)
+#include <dirent.h>
+#endif
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
+#if __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
 #include <cu0/env/environment_variable.hh>
 
 namespace cu0 {
@@ -29,6 +58,20 @@ struct Executable {
 
 namespace util {
 
+/*!
+ * @brief available ways to find an executable in a directory
+ */
+enum struct Lookup {
+  //! the path of the executable is checked with one ::fstatat() call
+  //! @note finds the same files as SCAN
+  EXISTS,
+  //! the path of the executable is checked with ::fstatat() and
+  //!     ::faccessat() calls => only executable regular files are found
+  EXECUTABLE,
+  //! the entries of the directory are compared with the name one by one
+  SCAN,
+};
+
 /*!
  * @brief finds an executable by a name
  * @note searches in order:
@@ -46,13 +89,32 @@ Executable find_by(const std::string& name);
  * @brief finds an executable by a name
  * @param name is the name of an executable
  * @param directory is the directory where to look for an executable
+ * @param lookup is the way to find the executable
  * @return executable with empty arguments and an empty environment
  */
 [[nodiscard]]
 Executable find_by(
     const std::string& name,
+    const std::filesystem::path& directory,
+    const Lookup& lookup = Lookup::EXISTS
+);
+
+#if __has_include(<dirent.h>)
+/*!
+ * @brief finds executables by names reading the entries of the directory
+ *     once @see Lookup::SCAN
+ * @param names are the names of executables
+ * @param directory is the directory where to look for executables
+ * @return executables with empty arguments and empty environments
+ *     in the order of the names,
+ *     if an executable is not found => its binary is empty
+ */
+[[nodiscard]]
+std::vector<Executable> find_by(
+    std::span<const std::string> names,
     const std::filesystem::path& directory
 );
+#endif
 
 /*!
  * @brief converts arguments of an executable to ptr<ptr<char[]>[]>
@@ -75,6 +137,37 @@ std::tuple<std::unique_ptr<std::unique_ptr<char[]>[]>, std::size_t> envp_of(
     const Executable& executable
 );
 
+/*!
+ * @brief converts arguments of an executable to one buffer of strings and
+ *     pointers to them allocated from a memory resource
+ * @param executable is the executable, arguments of which will be converted
+ * @param resource is the memory resource from which the buffer and
+ *     the pointers are allocated
+ * @return tuple containing the buffer and NULL-terminated pointers to
+ *     the strings of the buffer
+ */
+[[nodiscard]]
+std::tuple<std::pmr::vector<char>, std::pmr::vector<char*>> argv_of(
+    const Executable& executable,
+    std::pmr::memory_resource* resource
+);
+
+/*!
+ * @brief converts environment of an executable to one buffer of strings and
+ *     pointers to them allocated from a memory resource
+ *     @note in format of "key=value"
+ * @param executable is the executable, environment of which will be converted
+ * @param resource is the memory resource from which the buffer and
+ *     the pointers are allocated
+ * @return tuple containing the buffer and NULL-terminated pointers to
+ *     the strings of the buffer
+ */
+[[nodiscard]]
+std::tuple<std::pmr::vector<char>, std::pmr::vector<char*>> envp_of(
+    const Executable& executable,
+    std::pmr::memory_resource* resource
+);
+
 } /// namespace util
 
 } /// namespace cu0
@@ -123,8 +216,47 @@ inline Executable find_by(const std::string& name) {
 
 inline Executable find_by(
     const std::string& name,
-    const std::filesystem::path& directory
+    const std::filesystem::path& directory,
+    const Lookup& lookup
 ) {
+#if __has_include(<sys/stat.h>)
+  if (lookup != Lookup::SCAN) {
+    //! a name which is not a directory entry can not be found by a scan
+    if (
+        name.empty() ||
+        name == "." ||
+        name == ".." ||
+        name.find('/') != std::string::npos
+    ) {
+      return {};
+    }
+    auto path = directory / name;
+    struct stat status;
+    //! a symbolic link is a directory entry even if its target does not exist
+    if (
+        ::fstatat(
+            AT_FDCWD,
+            path.c_str(),
+            &status,
+            lookup == Lookup::EXISTS ? AT_SYMLINK_NOFOLLOW : 0
+        ) != 0
+    ) {
+      return {};
+    }
+    if (
+        lookup == Lookup::EXECUTABLE &&
+        (
+            !S_ISREG(status.st_mode) ||
+            ::faccessat(AT_FDCWD, path.c_str(), X_OK, AT_EACCESS) != 0
+        )
+    ) {
+      return {};
+    }
+    return { .binary = std::move(path) };
+  }
+#else
+  (void)lookup;
+#endif
   for (const auto& it : std::filesystem::directory_iterator{directory}) {
     if (it.path().filename() == name) {
       return { .binary = it.path() };
@@ -133,6 +265,47 @@ inline Executable find_by(
   return {};
 }
 
+#if __has_include(<dirent.h>)
+inline std::vector<Executable> find_by(
+    std::span<const std::string> names,
+    const std::filesystem::path& directory
+) {
+  auto executables = std::vector<Executable>(names.size());
+  //! the first index of each name
+  auto indices = std::unordered_map<std::string_view, std::size_t>{};
+  indices.reserve(names.size());
+  for (auto i = 0u; i < names.size(); i++) {
+    indices.emplace(names[i], i);
+  }
+  //! entries are read by ::getdents64() in large batches
+  const auto stream = ::opendir(directory.c_str());
+  if (stream == nullptr) {
+    return executables;
+  }
+  //! the scan stops when all the names are found
+  for (auto left = indices.size(); left > 0;) {
+    const auto entry = ::readdir(stream);
+    if (entry == nullptr) {
+      break;
+    }
+    const auto found = indices.find(std::string_view{entry->d_name});
+    if (found != indices.end()) {
+      executables[found->second].binary = directory / entry->d_name;
+      left--;
+    }
+  }
+  //! do not handle errors if any
+  ::closedir(stream);
+  //! duplicates share the result of the first name
+  for (auto i = 0u; i < names.size(); i++) {
+    if (const auto first = indices.at(names[i]); first != i) {
+      executables[i].binary = executables[first].binary;
+    }
+  }
+  return executables;
+}
+#endif
+
 inline std::tuple<std::unique_ptr<std::unique_ptr<char[]>[]>, std::size_t>
 argv_of(
     const Executable& executable
@@ -177,6 +350,63 @@ envp_of(
   return std::make_tuple(std::move(envp), size);
 }
 
+inline std::tuple<std::pmr::vector<char>, std::pmr::vector<char*>> argv_of(
+    const Executable& executable,
+    std::pmr::memory_resource* resource
+) {
+  //! argv == executable.binary + executable.arguments + NULL
+  const auto& binary = executable.binary.native();
+  auto size = binary.size() + 1;
+  for (const auto& argument : executable.arguments) {
+    size += argument.size() + 1;
+  }
+  auto strings = std::pmr::vector<char>{resource};
+  //! one allocation => pointers to the strings stay valid
+  strings.reserve(size);
+  auto offsets = std::pmr::vector<std::size_t>{resource};
+  offsets.reserve(1 + executable.arguments.size());
+  offsets.push_back(strings.size());
+  strings.insert(strings.end(), binary.begin(), binary.end());
+  strings.push_back('\0');
+  for (const auto& argument : executable.arguments) {
+    offsets.push_back(strings.size());
+    strings.insert(strings.end(), argument.begin(), argument.end());
+    strings.push_back('\0');
+  }
+  auto argv = std::pmr::vector<char*>{resource};
+  argv.reserve(offsets.size() + 1);
+  for (const auto& offset : offsets) {
+    argv.push_back(strings.data() + offset);
+  }
+  argv.push_back(NULL);
+  return std::make_tuple(std::move(strings), std::move(argv));
+}
+
+inline std::tuple<std::pmr::vector<char>, std::pmr::vector<char*>> envp_of(
+    const Executable& executable,
+    std::pmr::memory_resource* resource
+) {
+  //! envp == formatted(executable.environment) + NULL
+  auto size = std::size_t{0};
+  for (const auto& [key, value] : executable.environment) {
+    size += key.size() + 1 + value.size() + 1;
+  }
+  auto strings = std::pmr::vector<char>{resource};
+  //! one allocation => pointers to the strings stay valid
+  strings.reserve(size);
+  auto envp = std::pmr::vector<char*>{resource};
+  envp.reserve(executable.environment.size() + 1);
+  for (const auto& [key, value] : executable.environment) {
+    envp.push_back(strings.data() + strings.size());
+    strings.insert(strings.end(), key.begin(), key.end());
+    strings.push_back('=');
+    strings.insert(strings.end(), value.begin(), value.end());
+    strings.push_back('\0');
+  }
+  envp.push_back(NULL);
+  return std::make_tuple(std::move(strings), std::move(envp));
+}
+
 } /// namespace util
 
 } /// namespace cu0
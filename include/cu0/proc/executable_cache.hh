@@ -0,0 +1,401 @@
+#ifndef CU0_EXECUTABLE_CACHE_HH__
+#define CU0_EXECUTABLE_CACHE_HH__
+
+#if !__has_include(<sys/stat.h>)
+#warning <sys/stat.h> is not found => \
+    cu0::ExecutableCache will not be supported
+#warning <sys/stat.h> is not found => \
+    cu0::util::find_by_cached() will not be supported
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#endif
+
+#include <cu0/env/environment_index.hh>
+#include <cu0/env/environment_variable.hh>
+#include <cu0/proc/executable.hh>
+
+namespace cu0 {
+
+#if __has_include(<sys/stat.h>)
+/*!
+ * @brief The ExecutableCache struct provides a way to find executables by
+ *     names without searching directories again
+ * @note a found executable is returned from the cache while
+ *     the PATH environment variable, the current directory and
+ *     modification times of the searched directories are the same
+ * @note results are cached per value of the PATH environment variable
+ *     read from EnvironmentIndex::find_current() and the current directory
+ *     and the searched directories are checked at most once per interval =>
+ *     a hit does not access the file system
+ * @note thread-safe
+ */
+struct ExecutableCache {
+public:
+  /*!
+   * @brief constructs an instance checking the current directory and
+   *     the searched directories at most once per default interval
+   *     @see DEFAULT_INTERVAL
+   */
+  ExecutableCache() = default;
+  /*!
+   * @brief constructs an instance checking the current directory and
+   *     the searched directories at most once per the specified interval
+   * @param interval is the interval, if 0 => checked on every call
+   */
+  explicit ExecutableCache(std::chrono::nanoseconds interval);
+  /*!
+   * @brief finds an executable by a name @see util::find_by()
+   * @note a change of the current directory or a searched directory is
+   *     observed up to the interval later
+   * @param name is the name of an executable
+   * @return executable with empty arguments and an empty environment
+   */
+  [[nodiscard]]
+  Executable find_by(const std::string& name);
+  /*!
+   * @brief removes all the cached executables
+   */
+  void clear();
+  /*!
+   * @brief accesses the number of cached executables
+   * @return number of executables
+   */
+  [[nodiscard]]
+  std::size_t size() const;
+protected:
+  //! interval at which the directories of an entry are checked by default
+  static constexpr auto DEFAULT_INTERVAL = std::chrono::seconds{1};
+  //! state of a searched directory
+  struct Directory {
+    //! path of the directory
+    std::filesystem::path path;
+    //! true if the path is a directory
+    bool exists;
+    //! inode of the directory
+    ino_t inode;
+    //! modification time of the directory
+    timespec modified;
+  };
+  //! result of a search
+  struct Entry {
+    //! coarse monotonic time in nanoseconds when the entry is checked
+    std::int64_t checked;
+    //! current directory during the search
+    std::filesystem::path current;
+    //! found executable
+    Executable executable;
+    //! searched directories in the order of the search
+    std::vector<Directory> directories;
+  };
+  /*!
+   * @brief reads the state of a directory
+   * @param path is the path of the directory
+   * @return state of the directory
+   */
+  [[nodiscard]]
+  static Directory observe(const std::filesystem::path& path);
+  /*!
+   * @brief checks if the state of a directory has not changed
+   * @param directory is the state of the directory read before
+   * @return true if the state has not changed else false
+   */
+  [[nodiscard]]
+  static bool unchanged(const Directory& directory);
+  /*!
+   * @brief searches for an executable
+   * @param name is the name of an executable
+   * @param path_variable is the value of the PATH environment variable
+   * @param current is the current directory
+   * @return
+   *     if the result can be cached => result of the search
+   *     else => empty optional and the found executable is assigned to
+   *         the specified executable
+   */
+  [[nodiscard]]
+  static std::optional<Entry> search(
+      const std::string& name,
+      std::string_view path_variable,
+      const std::filesystem::path& current,
+      Executable& executable
+  );
+  //! key of an entry: value of the PATH environment variable and
+  //!     name of an executable
+  using Key = std::pair<std::string, std::string>;
+  //! key of an entry which does not own its strings
+  using KeyView = std::pair<std::string_view, std::string_view>;
+  //! hashes keys and views of keys
+  struct KeyHash {
+  public:
+    using is_transparent = void;
+    [[nodiscard]]
+    std::size_t operator ()(const KeyView& key) const;
+  protected:
+  private:
+  };
+  //! compares keys and views of keys
+  struct KeyEqual {
+  public:
+    using is_transparent = void;
+    [[nodiscard]]
+    bool operator ()(const KeyView& lhs, const KeyView& rhs) const;
+  protected:
+  private:
+  };
+  /*!
+   * @brief reads the coarse monotonic clock
+   * @return time in nanoseconds
+   */
+  [[nodiscard]]
+  static std::int64_t now();
+  //! interval at which the directories of an entry are checked
+  std::chrono::nanoseconds interval_ = DEFAULT_INTERVAL;
+  //! guards entries_
+  mutable std::mutex mutex_;
+  //! cached results by values of PATH and names of executables
+  //! @note looked up by KeyView => a hit does not allocate a key
+  std::unordered_map<Key, Entry, KeyHash, KeyEqual> entries_;
+private:
+};
+#endif
+
+namespace util {
+
+#if __has_include(<sys/stat.h>)
+/*!
+ * @brief finds an executable by a name using a cache shared by the process
+ *     @see ExecutableCache::find_by()
+ * @param name is the name of an executable
+ * @return executable with empty arguments and an empty environment
+ */
+[[nodiscard]]
+Executable find_by_cached(const std::string& name);
+#endif
+
+} /// namespace util
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<sys/stat.h>)
+inline ExecutableCache::ExecutableCache(
+    std::chrono::nanoseconds interval
+) : interval_{std::move(interval)} {}
+
+inline Executable ExecutableCache::find_by(const std::string& name) {
+#if __has_include(<unistd.h>)
+  //! the index is rebuilt only if the environment has changed =>
+  //!     PATH is not copied
+  const auto path_variable =
+      EnvironmentIndex::find_current("PATH").value_or("");
+#else
+  const auto path_value =
+      EnvironmentVariable::synced("PATH").cached().value_or("");
+  const auto path_variable = std::string_view{path_value};
+#endif
+  const auto key = KeyView{path_variable, name};
+  //! copy of the entry to be checked without the lock
+  auto checked = std::optional<Entry>{};
+  {
+    const auto lock = std::lock_guard{this->mutex_};
+    const auto found = this->entries_.find(key);
+    if (found != this->entries_.end()) {
+      const auto now = ExecutableCache::now();
+      if (now - found->second.checked < this->interval_.count()) {
+        return found->second.executable;
+      }
+      //! other callers use the entry while it is checked
+      found->second.checked = now;
+      checked = found->second;
+    }
+  }
+  //! the file system is accessed without the lock not to block other callers
+  const auto current = std::filesystem::current_path();
+  if (checked.has_value() && checked->current == current) {
+    auto valid = true;
+    for (const auto& directory : checked->directories) {
+      if (!ExecutableCache::unchanged(directory)) {
+        valid = false;
+        break;
+      }
+    }
+    if (valid) {
+      return std::move(checked->executable);
+    }
+  }
+  auto executable = Executable{};
+  auto entry = ExecutableCache::search(
+      name,
+      path_variable,
+      current,
+      executable
+  );
+  const auto lock = std::lock_guard{this->mutex_};
+  if (!entry.has_value()) {
+    const auto found = this->entries_.find(key);
+    if (found != this->entries_.end()) {
+      this->entries_.erase(found);
+    }
+    return executable;
+  }
+  auto& cached = this->entries_[Key{path_variable, name}];
+  cached = std::move(entry.value());
+  return cached.executable;
+}
+
+inline void ExecutableCache::clear() {
+  const auto lock = std::lock_guard{this->mutex_};
+  this->entries_.clear();
+}
+
+inline std::size_t ExecutableCache::size() const {
+  const auto lock = std::lock_guard{this->mutex_};
+  return this->entries_.size();
+}
+
+inline std::size_t ExecutableCache::KeyHash::operator ()(
+    const KeyView& key
+) const {
+  const auto first = std::hash<std::string_view>{}(key.first);
+  const auto second = std::hash<std::string_view>{}(key.second);
+  return first ^ (second + 0x9e3779b97f4a7c15ull + (first << 6) + (first >> 2));
+}
+
+inline bool ExecutableCache::KeyEqual::operator ()(
+    const KeyView& lhs,
+    const KeyView& rhs
+) const {
+  return lhs == rhs;
+}
+
+inline std::int64_t ExecutableCache::now() {
+  timespec now;
+  ::clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+  return std::int64_t{now.tv_sec} * 1000000000 + now.tv_nsec;
+}
+
+inline typename ExecutableCache::Directory ExecutableCache::observe(
+    const std::filesystem::path& path
+) {
+  struct stat status;
+  if (::stat(path.c_str(), &status) != 0 || !S_ISDIR(status.st_mode)) {
+    return {
+      .path = path,
+      .exists = false,
+      .inode = 0,
+      .modified = {},
+    };
+  }
+  return {
+    .path = path,
+    .exists = true,
+    .inode = status.st_ino,
+    .modified = status.st_mtim,
+  };
+}
+
+inline bool ExecutableCache::unchanged(const Directory& directory) {
+  const auto now = ExecutableCache::observe(directory.path);
+  return
+      now.exists == directory.exists &&
+      now.inode == directory.inode &&
+      now.modified.tv_sec == directory.modified.tv_sec &&
+      now.modified.tv_nsec == directory.modified.tv_nsec;
+}
+
+inline std::optional<typename ExecutableCache::Entry> ExecutableCache::search(
+    const std::string& name,
+    std::string_view path_variable,
+    const std::filesystem::path& current,
+    Executable& executable
+) {
+  //! a directory modified at the same time as it is searched
+  //!     may be modified again without a change of its modification time =>
+  //!     such a search is not cached
+  //! modification times are taken from the coarse clock
+  timespec start;
+  ::clock_gettime(CLOCK_REALTIME_COARSE, &start);
+  auto entry = Entry{
+    .checked = ExecutableCache::now(),
+    .current = current,
+    .executable = {},
+    .directories = {},
+  };
+  auto cacheable = true;
+  //! returns true if the executable is found in the directory
+  const auto search_in = [&](const std::filesystem::path& path) {
+    //! the state is read before the search for a later modification
+    //!     to invalidate the result
+    const auto& directory =
+        entry.directories.emplace_back(ExecutableCache::observe(path));
+    if (!directory.exists) {
+      return false;
+    }
+    if (
+        directory.modified.tv_sec > start.tv_sec ||
+        (
+            directory.modified.tv_sec == start.tv_sec &&
+            directory.modified.tv_nsec >= start.tv_nsec
+        )
+    ) {
+      cacheable = false;
+    }
+    entry.executable = util::find_by(name, path);
+    return !entry.executable.binary.empty();
+  };
+  if (!search_in(current) && !path_variable.empty()) {
+    auto paths_left = path_variable;
+    while (true) {
+      const auto pos = paths_left.find(
+#if !defined(NOT_AN_X)
+          ':'
+#else
+          ';'
+#endif
+      );
+      if (search_in(paths_left.substr(0, pos))) {
+        break;
+      }
+      if (pos == std::string_view::npos) {
+        break;
+      }
+      paths_left.remove_prefix(pos + 1);
+    }
+  }
+  if (!cacheable) {
+    executable = std::move(entry.executable);
+    return {};
+  }
+  return entry;
+}
+#endif
+
+namespace util {
+
+#if __has_include(<sys/stat.h>)
+inline Executable find_by_cached(const std::string& name) {
+  static auto cache = ExecutableCache{};
+  return cache.find_by(name);
+}
+#endif
+
+} /// namespace util
+
+} /// namespace cu0
+
+#endif /// CU0_EXECUTABLE_CACHE_HH__
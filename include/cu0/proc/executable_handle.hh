@@ -0,0 +1,256 @@
+#ifndef CU0_EXECUTABLE_HANDLE_HH__
+#define CU0_EXECUTABLE_HANDLE_HH__
+
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::ExecutableHandle will not be supported
+#endif
+#if !__has_include(<sys/mman.h>)
+#warning <sys/mman.h> is not found => \
+    cu0::ExecutableHandle::load() will not be supported
+#endif
+#if !__has_include(<sys/sendfile.h>)
+#warning <sys/sendfile.h> is not found => \
+    cu0::ExecutableHandle::load() will not be supported
+#endif
+
+#include <cerrno>
+#include <filesystem>
+#include <variant>
+
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+#if __has_include(<sys/sendfile.h>)
+#include <sys/sendfile.h>
+#endif
+#if __has_include(<sys/stat.h>)
+#include <sys/stat.h>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace cu0 {
+
+#if __has_include(<fcntl.h>)
+/*!
+ * @brief The ExecutableHandle struct represents an opened binary which can
+ *     be run without resolving its path again
+ *     @see SpawnOptions::binary
+ * @note a binary is run by its file descriptor => interpreter scripts
+ *     (starting with #!) can not be run by a handle
+ */
+struct ExecutableHandle {
+public:
+  /*!
+   * @brief enum of possible errors for open() and load() functions
+   */
+  enum struct OpenError {
+    ACCES = EACCES, //! @see EACCES
+    FBIG = EFBIG, //! @see EFBIG
+    IO = EIO, //! @see EIO
+    ISDIR = EISDIR, //! @see EISDIR
+    LOOP = ELOOP, //! @see ELOOP
+    MFILE = EMFILE, //! @see EMFILE
+    NAMETOOLONG = ENAMETOOLONG, //! @see ENAMETOOLONG
+    NFILE = ENFILE, //! @see ENFILE
+    NOENT = ENOENT, //! @see ENOENT
+    NOMEM = ENOMEM, //! @see ENOMEM
+    NOSPC = ENOSPC, //! @see ENOSPC
+    NOTDIR = ENOTDIR, //! @see ENOTDIR
+    PERM = EPERM, //! @see EPERM
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::open(), ::memfd_create(),
+    //!     ::sendfile() and ::fcntl()
+  };
+  /*!
+   * @brief opens the specified binary
+   * @note the binary is referred to by an O_PATH file descriptor =>
+   *     its path is not resolved when it is run
+   * @param binary is the path of the binary
+   * @return
+   *     if no error was reported => handle of the binary
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<ExecutableHandle, OpenError> open(
+      const std::filesystem::path& binary
+  );
+#if __has_include(<sys/mman.h>) && __has_include(<sys/sendfile.h>)
+  /*!
+   * @brief copies the specified binary into memory
+   * @note the copy is not affected by the filesystem of the binary =>
+   *     neither by its modifications nor by its slowness
+   * @note the copy is sealed => it can not be modified
+   * @param binary is the path of the binary
+   * @return
+   *     if no error was reported => handle of the copy of the binary
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<ExecutableHandle, OpenError> load(
+      const std::filesystem::path& binary
+  );
+#endif
+  /*!
+   * @brief destructs an instance
+   */
+  virtual ~ExecutableHandle();
+  constexpr ExecutableHandle(const ExecutableHandle& other) = delete;
+  constexpr ExecutableHandle& operator =(
+      const ExecutableHandle& other
+  ) = delete;
+  /*!
+   * @brief moves handle resources to this handle
+   * @param other is the handle for which resources need to be moved
+   */
+  constexpr ExecutableHandle(ExecutableHandle&& other);
+  /*!
+   * @brief moves handle resources to this handle
+   * @param other is the handle for which resources need to be moved
+   * @return this handle as a mutable reference
+   */
+  constexpr ExecutableHandle& operator =(ExecutableHandle&& other);
+  /*!
+   * @brief accesses the file descriptor of the binary
+   * @return file descriptor as a const reference
+   */
+  [[nodiscard]]
+  constexpr const int& fd() const;
+protected:
+  /*!
+   * @brief constructs an instance with default values
+   */
+  constexpr ExecutableHandle() = default;
+  /*!
+   * @brief swaps two handles
+   * @param other is the handle to swap this handle with
+   */
+  constexpr void swap(ExecutableHandle&& other);
+  //! file descriptor of the binary
+  int fd_ = -1;
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<fcntl.h>)
+inline std::variant<ExecutableHandle, typename ExecutableHandle::OpenError>
+ExecutableHandle::open(
+    const std::filesystem::path& binary
+) {
+  const auto fd = ::open(binary.c_str(), O_PATH | O_CLOEXEC);
+  if (fd < 0) {
+    return static_cast<OpenError>(errno);
+  }
+  auto handle = ExecutableHandle{};
+  handle.fd_ = fd;
+  return handle;
+}
+#endif
+
+#if \
+    __has_include(<fcntl.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/sendfile.h>)
+inline std::variant<ExecutableHandle, typename ExecutableHandle::OpenError>
+ExecutableHandle::load(
+    const std::filesystem::path& binary
+) {
+  const auto source = ::open(binary.c_str(), O_RDONLY | O_CLOEXEC);
+  if (source < 0) {
+    return static_cast<OpenError>(errno);
+  }
+  struct stat status;
+  if (::fstat(source, &status) != 0) {
+    const auto ret = static_cast<OpenError>(errno);
+    //! do not handle errors if any
+    ::close(source);
+    return ret;
+  }
+  auto handle = ExecutableHandle{};
+  constexpr auto FLAGS = MFD_CLOEXEC | MFD_ALLOW_SEALING;
+#if defined(MFD_EXEC)
+  //! if vm.memfd_noexec is 1 => a memfd is not executable by default
+  handle.fd_ = ::memfd_create(binary.filename().c_str(), FLAGS | MFD_EXEC);
+  if (handle.fd_ < 0 && errno == EINVAL) {
+    //! kernels before 6.3 do not know MFD_EXEC
+    handle.fd_ = ::memfd_create(binary.filename().c_str(), FLAGS);
+  }
+#else
+  handle.fd_ = ::memfd_create(binary.filename().c_str(), FLAGS);
+#endif
+  if (handle.fd_ < 0) {
+    const auto ret = static_cast<OpenError>(errno);
+    //! do not handle errors if any
+    ::close(source);
+    return ret;
+  }
+  for (auto copied = off_t{0}; copied < status.st_size;) {
+    const auto bytes = ::sendfile(
+        handle.fd_,
+        source,
+        nullptr,
+        status.st_size - copied
+    );
+    if (bytes <= 0) {
+      //! the binary is truncated while it is being copied => EIO
+      const auto ret = static_cast<OpenError>(bytes < 0 ? errno : EIO);
+      //! do not handle errors if any
+      ::close(source);
+      return ret;
+    }
+    copied += bytes;
+  }
+  //! do not handle errors if any
+  ::close(source);
+  //! the copy can not be modified anymore
+  if (::fcntl(
+      handle.fd_,
+      F_ADD_SEALS,
+      F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL
+  ) != 0) {
+    return static_cast<OpenError>(errno);
+  }
+  return handle;
+}
+#endif
+
+#if __has_include(<fcntl.h>)
+inline ExecutableHandle::~ExecutableHandle() {
+  //! do not handle errors if any
+  ::close(this->fd_);
+}
+
+constexpr ExecutableHandle::ExecutableHandle(ExecutableHandle&& other) {
+  this->swap(std::move(other));
+}
+
+constexpr ExecutableHandle& ExecutableHandle::operator =(
+    ExecutableHandle&& other
+) {
+  if (this != &other) {
+    this->swap(std::move(other));
+  }
+  return *this;
+}
+
+constexpr const int& ExecutableHandle::fd() const {
+  return this->fd_;
+}
+
+constexpr void ExecutableHandle::swap(ExecutableHandle&& other) {
+  std::swap(this->fd_, other.fd_);
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_EXECUTABLE_HANDLE_HH__
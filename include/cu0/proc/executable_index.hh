@@ -0,0 +1,202 @@
+#ifndef CU0_EXECUTABLE_INDEX_HH__
+#define CU0_EXECUTABLE_INDEX_HH__
+
+#if !__has_include(<dirent.h>)
+#warning <dirent.h> is not found => \
+    cu0::ExecutableIndex will not be supported
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<dirent.h>)
+#include <dirent.h>
+#endif
+
+#include <cu0/env/environment_variable.hh>
+#include <cu0/proc/executable.hh>
+
+namespace cu0 {
+
+#if __has_include(<dirent.h>)
+/*!
+ * @brief The ExecutableIndex struct represents a snapshot of the names of
+ *     the files in directories which is used to find many executables
+ *     without reading the directories again
+ * @note the snapshot is not updated => create a new index after
+ *     the directories are modified
+ */
+struct ExecutableIndex {
+public:
+  /*!
+   * @brief creates an index of the directories searched by util::find_by()
+   * @note the directories in order:
+   *     the current directory
+   *     the directories specified by the PATH environment variable
+   * @return created index
+   */
+  [[nodiscard]]
+  static ExecutableIndex create();
+  /*!
+   * @brief creates an index of the specified directories
+   * @note a directory which can not be read is skipped
+   * @param directories are the directories in the order of the search
+   * @return created index
+   */
+  [[nodiscard]]
+  static ExecutableIndex create(
+      std::span<const std::filesystem::path> directories
+  );
+  /*!
+   * @brief finds an executable by a name
+   * @param name is the name of an executable
+   * @return executable with empty arguments and an empty environment
+   * @note if multiple executables are present with the specified name =>
+   *     the executable of the first directory is returned
+   */
+  [[nodiscard]]
+  Executable find_by(std::string_view name) const;
+  /*!
+   * @brief accesses the number of indexed names
+   * @return number of names
+   */
+  [[nodiscard]]
+  std::size_t size() const;
+protected:
+  //! indexed name
+  struct Name {
+    //! offset of the name in names_
+    std::uint32_t offset;
+    //! size of the name
+    std::uint32_t size;
+    //! index of the directory of the name in directories_
+    std::uint32_t directory;
+  };
+  /*!
+   * @brief accesses an indexed name as a string
+   * @param name is the indexed name
+   * @return name as a string view
+   */
+  [[nodiscard]]
+  std::string_view view(const Name& name) const;
+  //! indexed directories in the order of the search
+  std::vector<std::filesystem::path> directories_{};
+  //! all the names stored one after another
+  std::string names_{};
+  //! sorted names with unique values
+  std::vector<Name> index_{};
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<dirent.h>)
+inline ExecutableIndex ExecutableIndex::create() {
+  auto directories = std::vector<std::filesystem::path>{
+    std::filesystem::current_path(),
+  };
+  const auto environment_variable = EnvironmentVariable::synced("PATH");
+  const auto& optional = environment_variable.cached();
+  if (optional.has_value() && !optional.value().empty()) {
+    auto paths_left = std::string_view{optional.value()};
+    while (true) {
+      const auto pos = paths_left.find(
+#if !defined(NOT_AN_X)
+          ':'
+#else
+          ';'
+#endif
+      );
+      directories.emplace_back(paths_left.substr(0, pos));
+      if (pos == std::string_view::npos) {
+        break;
+      }
+      paths_left.remove_prefix(pos + 1);
+    }
+  }
+  return ExecutableIndex::create(directories);
+}
+
+inline ExecutableIndex ExecutableIndex::create(
+    std::span<const std::filesystem::path> directories
+) {
+  auto index = ExecutableIndex{};
+  index.directories_.assign(directories.begin(), directories.end());
+  for (auto i = 0u; i < index.directories_.size(); i++) {
+    //! entries are read by ::getdents64() in large batches
+    const auto stream = ::opendir(index.directories_[i].c_str());
+    if (stream == nullptr) {
+      continue;
+    }
+    for (auto entry = ::readdir(stream); entry; entry = ::readdir(stream)) {
+      const auto name = std::string_view{entry->d_name};
+      if (name == "." || name == "..") {
+        continue;
+      }
+      index.index_.push_back({
+        .offset = static_cast<std::uint32_t>(index.names_.size()),
+        .size = static_cast<std::uint32_t>(name.size()),
+        .directory = i,
+      });
+      index.names_.append(name);
+    }
+    //! do not handle errors if any
+    ::closedir(stream);
+  }
+  //! names of earlier directories stay first among equal names
+  std::stable_sort(
+      index.index_.begin(),
+      index.index_.end(),
+      [&index](const Name& lhs, const Name& rhs) {
+        return index.view(lhs) < index.view(rhs);
+      }
+  );
+  index.index_.erase(
+      std::unique(
+          index.index_.begin(),
+          index.index_.end(),
+          [&index](const Name& lhs, const Name& rhs) {
+            return index.view(lhs) == index.view(rhs);
+          }
+      ),
+      index.index_.end()
+  );
+  index.index_.shrink_to_fit();
+  return index;
+}
+
+inline Executable ExecutableIndex::find_by(std::string_view name) const {
+  const auto found = std::lower_bound(
+      this->index_.begin(),
+      this->index_.end(),
+      name,
+      [this](const Name& lhs, const std::string_view& rhs) {
+        return this->view(lhs) < rhs;
+      }
+  );
+  if (found == this->index_.end() || this->view(*found) != name) {
+    return {};
+  }
+  return { .binary = this->directories_[found->directory] / name };
+}
+
+inline std::size_t ExecutableIndex::size() const {
+  return this->index_.size();
+}
+
+inline std::string_view ExecutableIndex::view(const Name& name) const {
+  return std::string_view{this->names_}.substr(name.offset, name.size);
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_EXECUTABLE_INDEX_HH__
@@ -0,0 +1,568 @@
+#ifndef CU0_FORK_SERVER_HH__
+#define CU0_FORK_SERVER_HH__
+
+#if !__has_include(<sys/socket.h>)
+#warning <sys/socket.h> is not found => \
+    cu0::ForkServer will not be supported
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::ForkServer will not be supported
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <variant>
+#include <vector>
+
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
+#if __has_include(<sched.h>)
+#include <sched.h>
+#endif
+#if __has_include(<sys/prctl.h>)
+#include <sys/prctl.h>
+#endif
+#if __has_include(<sys/socket.h>)
+#include <sys/socket.h>
+#endif
+#if __has_include(<sys/syscall.h>)
+#include <sys/syscall.h>
+#endif
+
+#include <cu0/proc/process.hh>
+
+namespace cu0 {
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+/*!
+ * @brief The ForkServer struct provides a way to create processes by a small
+ *     helper process which is launched beforehand
+ * @note the cost of creating a process by the helper does not depend on the
+ *     memory footprint of the process which launched the helper
+ * @note processes are created as children of the process which launched the
+ *     helper, i.e. they can be waited, signaled, etc. in the same way as the
+ *     processes created by Process::create()
+ * @note the helper is a copy of the process at the moment of launch =>
+ *     launch it before other threads are created, e.g. at the start of main()
+ */
+struct ForkServer {
+public:
+  /*!
+   * @brief enum of possible errors for launch() function
+   */
+  enum struct LaunchError {
+    AGAIN = EAGAIN, //! @see EAGAIN
+    NOMEM = ENOMEM, //! @see ENOMEM
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::socketpair() and ::fork()
+  };
+  /*!
+   * @brief launches a helper process which will create processes on request
+   * @return
+   *     if no error was reported => fork server connected to the helper
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<ForkServer, LaunchError> launch();
+  /*!
+   * @brief destructs an instance
+   * @note the helper process exits and is waited
+   */
+  virtual ~ForkServer();
+  constexpr ForkServer(const ForkServer& other) = delete;
+  constexpr ForkServer& operator =(const ForkServer& other) = delete;
+  /*!
+   * @brief moves fork server resources to this fork server
+   * @param other is the fork server for which resources need to be moved
+   */
+  constexpr ForkServer(ForkServer&& other);
+  /*!
+   * @brief moves fork server resources to this fork server
+   * @param other is the fork server for which resources need to be moved
+   * @return this fork server as a mutable reference
+   */
+  constexpr ForkServer& operator =(ForkServer&& other);
+  /*!
+   * @brief accesses process identifier value of the helper process
+   * @return process identifier as a const reference
+   */
+  [[nodiscard]]
+  constexpr const unsigned& pid() const;
+  /*!
+   * @brief creates a process using the specified executable by the helper
+   * @note pipes of the created process are passed from the helper
+   * @note if the pipes can not be received, e.g. the file descriptor table is
+   *     full => the created process is killed and waited, and an error is
+   *     returned
+   * @note not thread-safe => requests from multiple threads need to be
+   *     serialized by the caller
+   * @param executable is the excutable to be run by the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<Process, Process::CreateError> create(
+      const Executable& executable
+  ) const;
+  /*!
+   * @brief creates a process without pipes using the specified executable by
+   *     the helper
+   * @note not thread-safe => requests from multiple threads need to be
+   *     serialized by the caller
+   * @param executable is the excutable to be run by the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<Process, Process::CreateError> create_pipeless(
+      const Executable& executable
+  ) const;
+protected:
+  //! header of a request sent to the helper process
+  struct Request {
+    //! non-zero if pipes need to be created
+    std::uint32_t pipes;
+    //! number of argv strings following the request (excluding NULL)
+    std::uint32_t argc;
+    //! number of envp strings following argv strings (excluding NULL)
+    std::uint32_t envc;
+    //! size of all the strings following the request in bytes
+    std::uint64_t size;
+  };
+  //! reply sent by the helper process
+  //! @note stdin, stdout and stderr pipes are attached as SCM_RIGHTS if
+  //!     requested and if no error was reported
+  struct Reply {
+    //! if no error was reported => 0
+    //! else => error code
+    std::int32_t error;
+    //! process identifier of the created process
+    std::uint32_t pid;
+  };
+  /*!
+   * @brief sends a request to the helper process and receives a reply
+   * @tparam PIPES specifies if pipes need to be created
+   * @param executable is the excutable to be run by the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  template <bool PIPES>
+  [[nodiscard]]
+  std::variant<Process, Process::CreateError> request(
+      const Executable& executable
+  ) const;
+  /*!
+   * @brief serves requests in the helper process until the socket is closed
+   * @param socket is the helper end of the socket
+   */
+  [[noreturn]]
+  static void serve(const int& socket);
+  /*!
+   * @brief writes all the specified data into the socket
+   * @param socket is the socket to write into
+   * @param data is the data to write
+   * @param size is the size of the data in bytes
+   * @return true if all the data were written else false
+   */
+  static bool send_all(const int& socket, const void* data, std::size_t size);
+  /*!
+   * @brief reads the specified number of bytes from the socket
+   * @param socket is the socket to read from
+   * @param data is the buffer to read into
+   * @param size is the number of bytes to read
+   * @return true if all the bytes were read else false
+   */
+  static bool receive_all(const int& socket, void* data, std::size_t size);
+  /*!
+   * @brief closes all the file descriptors received as SCM_RIGHTS
+   * @param message is the received message
+   */
+  static void close_rights(::msghdr& message);
+  /*!
+   * @brief constructs an instance with default values
+   */
+  constexpr ForkServer() = default;
+  /*!
+   * @brief swaps two fork servers
+   * @param other is the fork server to swap this fork server with
+   */
+  constexpr void swap(ForkServer&& other);
+  //! process identifier of the helper process
+  unsigned pid_ = 0;
+  //! socket connected to the helper process
+  int socket_ = -1;
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline std::variant<ForkServer, typename ForkServer::LaunchError>
+ForkServer::launch() {
+  int sockets[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) != 0) {
+    return static_cast<LaunchError>(errno);
+  }
+  const auto pid = ::fork();
+  if (pid == 0) { //! helper process
+    //! do not handle errors if any
+    ::close(sockets[0]);
+#if __has_include(<sys/prctl.h>)
+    //! the helper is not needed after the process which launched it exits
+    ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+#if defined(CLOSE_RANGE_CLOEXEC)
+    //! the helper should not keep file descriptors of the launching process
+    //!     open, except for stdin, stdout and stderr
+    if (sockets[1] > 3) {
+      ::close_range(3, sockets[1] - 1, 0);
+    }
+    ::close_range(sockets[1] + 1, ~0u, 0);
+#endif
+    ForkServer::serve(sockets[1]);
+  }
+  //! do not handle errors if any
+  ::close(sockets[1]);
+  if (pid < 0) { //! fork failed
+    const auto ret = static_cast<LaunchError>(errno);
+    //! do not handle errors if any
+    ::close(sockets[0]);
+    return ret;
+  }
+  auto ret = ForkServer{};
+  ret.pid_ = pid;
+  ret.socket_ = sockets[0];
+  return ret;
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline ForkServer::~ForkServer() {
+  if (this->socket_ < 0) {
+    return;
+  }
+  //! the helper exits after the socket is closed
+  //! do not handle errors if any
+  ::close(this->socket_);
+  int status;
+  ::waitpid(this->pid_, &status, 0);
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+constexpr ForkServer::ForkServer(ForkServer&& other) {
+  this->swap(std::move(other));
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+constexpr ForkServer& ForkServer::operator =(ForkServer&& other) {
+  if (this != &other) {
+    this->swap(std::move(other));
+  }
+  return *this;
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+constexpr const unsigned& ForkServer::pid() const {
+  return this->pid_;
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline std::variant<Process, typename Process::CreateError> ForkServer::create(
+    const Executable& executable
+) const {
+  return this->request<true>(executable);
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline std::variant<Process, typename Process::CreateError>
+ForkServer::create_pipeless(
+    const Executable& executable
+) const {
+  return this->request<false>(executable);
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+template <bool PIPES>
+inline std::variant<Process, typename Process::CreateError>
+ForkServer::request(
+    const Executable& executable
+) const {
+  //! strings == binary + arguments + formatted(environment)
+  //!     each of which is terminated by '\0'
+  auto strings = executable.binary.string();
+  strings += '\0';
+  for (const auto& argument : executable.arguments) {
+    strings += argument;
+    strings += '\0';
+  }
+  for (const auto& [key, value] : executable.environment) {
+    strings += key;
+    strings += '=';
+    strings += value;
+    strings += '\0';
+  }
+  const auto request = Request{
+    .pipes = PIPES,
+    .argc = static_cast<std::uint32_t>(1 + executable.arguments.size()),
+    .envc = static_cast<std::uint32_t>(executable.environment.size()),
+    .size = strings.size(),
+  };
+  if (
+      !ForkServer::send_all(this->socket_, &request, sizeof(request)) ||
+      !ForkServer::send_all(this->socket_, strings.data(), strings.size())
+  ) {
+    return static_cast<Process::CreateError>(errno);
+  }
+  auto reply = Reply{};
+  auto io_vector = ::iovec{ .iov_base = &reply, .iov_len = sizeof(reply), };
+  alignas(::cmsghdr) char control[CMSG_SPACE(3 * sizeof(int))];
+  auto message = ::msghdr{};
+  message.msg_iov = &io_vector;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  //! the reply is small => it is received in one go together with the pipes
+  const auto received = ::recvmsg(this->socket_, &message, MSG_CMSG_CLOEXEC);
+  if (received < 0) {
+    return static_cast<Process::CreateError>(errno);
+  }
+  if (received != sizeof(reply)) { //! the helper is gone
+    ForkServer::close_rights(message);
+    return Process::CreateError::AGAIN;
+  }
+  if (reply.error != 0) {
+    ForkServer::close_rights(message);
+    return static_cast<Process::CreateError>(reply.error);
+  }
+  auto process = Process{};
+  process.pid_ = reply.pid;
+  if constexpr (PIPES) {
+    const auto* header = CMSG_FIRSTHDR(&message);
+    const auto truncated = (message.msg_flags & MSG_CTRUNC) != 0;
+    if (
+        truncated ||
+        header == NULL ||
+        header->cmsg_level != SOL_SOCKET ||
+        header->cmsg_type != SCM_RIGHTS ||
+        header->cmsg_len != CMSG_LEN(3 * sizeof(int))
+    ) {
+      //! the pipes which did arrive are useless without the others
+      ForkServer::close_rights(message);
+      //! the process is created anyway => it is not left running without
+      //!     pipes and is waited not to become a zombie
+      //! do not handle errors if any
+      ::kill(reply.pid, SIGKILL);
+      int status;
+      ::waitpid(reply.pid, &status, 0);
+      //! the control data is truncated if there is no room for the pipes in
+      //!     the file descriptor table
+      return truncated ?
+          Process::CreateError::MFILE :
+          Process::CreateError::INVAL;
+    }
+    int pipes[3];
+    std::memcpy(pipes, CMSG_DATA(header), sizeof(pipes));
+    process.stdin_pipe_ = pipes[0];
+    process.stdout_pipe_ = pipes[1];
+    process.stderr_pipe_ = pipes[2];
+  }
+  return process;
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline void ForkServer::serve(const int& socket) {
+  auto strings = std::vector<char>{};
+  auto pointers = std::vector<char*>{};
+  while (true) {
+    auto request = Request{};
+    if (!ForkServer::receive_all(socket, &request, sizeof(request))) {
+      //! the socket is closed => no more requests
+      ::_exit(0);
+    }
+    strings.resize(request.size + 1);
+    if (!ForkServer::receive_all(socket, strings.data(), request.size)) {
+      ::_exit(0);
+    }
+    strings[request.size] = '\0';
+    //! pointers == argv + NULL + envp + NULL
+    pointers.clear();
+    auto offset = std::size_t{0};
+    for (auto i = 0u; i < request.argc + request.envc; i++) {
+      if (i == request.argc) { //! end of argv
+        pointers.push_back(NULL);
+      }
+      pointers.push_back(strings.data() + offset);
+      offset = std::min<std::size_t>(
+          offset + std::strlen(strings.data() + offset) + 1,
+          request.size
+      );
+    }
+    if (request.envc == 0) { //! end of argv
+      pointers.push_back(NULL);
+    }
+    pointers.push_back(NULL);
+    char** argv = pointers.data();
+    char** envp = pointers.data() + request.argc + 1;
+    auto reply = Reply{};
+    int in_fd[2] = { -1, -1, };
+    int out_fd[2] = { -1, -1, };
+    int err_fd[2] = { -1, -1, };
+    //! the pipes are created with O_CLOEXEC => only the duplicated ends are
+    //!     inherited by the created process
+    if (
+        request.pipes != 0 &&
+        (
+            ::pipe2(in_fd, O_CLOEXEC) != 0 ||
+            ::pipe2(out_fd, O_CLOEXEC) != 0 ||
+            ::pipe2(err_fd, O_CLOEXEC) != 0
+        )
+    ) {
+      reply.error = errno;
+    }
+    if (reply.error == 0) {
+      //! the helper is small => it is cheap to copy it
+      //! CLONE_PARENT makes the created process a child of the process which
+      //!     launched the helper
+      const auto pid = ::syscall(SYS_clone, CLONE_PARENT | SIGCHLD, 0, 0, 0, 0);
+      if (pid == 0) { //! created process
+        if (request.pipes != 0) {
+          //! do not handle errors if any
+          ::dup2(in_fd[0], STDIN_FILENO);
+          ::dup2(out_fd[1], STDOUT_FILENO);
+          ::dup2(err_fd[1], STDERR_FILENO);
+        }
+        ::execve(argv[0], argv, envp);
+        //! exec failed
+        ::_exit(errno);
+      }
+      if (pid < 0) { //! clone failed
+        reply.error = errno;
+      } else {
+        reply.pid = pid;
+      }
+    }
+    //! do not handle errors if any
+    ::close(in_fd[0]);
+    ::close(out_fd[1]);
+    ::close(err_fd[1]);
+    auto io_vector = ::iovec{ .iov_base = &reply, .iov_len = sizeof(reply), };
+    alignas(::cmsghdr) char control[CMSG_SPACE(3 * sizeof(int))];
+    auto message = ::msghdr{};
+    message.msg_iov = &io_vector;
+    message.msg_iovlen = 1;
+    if (request.pipes != 0 && reply.error == 0) {
+      message.msg_control = control;
+      message.msg_controllen = sizeof(control);
+      auto* header = CMSG_FIRSTHDR(&message);
+      header->cmsg_level = SOL_SOCKET;
+      header->cmsg_type = SCM_RIGHTS;
+      header->cmsg_len = CMSG_LEN(3 * sizeof(int));
+      const int pipes[3] = { in_fd[1], out_fd[0], err_fd[0], };
+      std::memcpy(CMSG_DATA(header), pipes, sizeof(pipes));
+    }
+    const auto sent = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+    //! do not handle errors if any
+    ::close(in_fd[1]);
+    ::close(out_fd[0]);
+    ::close(err_fd[0]);
+    if (sent != sizeof(reply)) {
+      ::_exit(0);
+    }
+  }
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline bool ForkServer::send_all(
+    const int& socket,
+    const void* data,
+    std::size_t size
+) {
+  const auto* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const auto sent = ::send(socket, bytes, size, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += sent;
+    size -= sent;
+  }
+  return true;
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline bool ForkServer::receive_all(
+    const int& socket,
+    void* data,
+    std::size_t size
+) {
+  auto* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    const auto received = ::recv(socket, bytes, size, 0);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received <= 0) {
+      return false;
+    }
+    bytes += received;
+    size -= received;
+  }
+  return true;
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+inline void ForkServer::close_rights(::msghdr& message) {
+  for (
+      auto* header = CMSG_FIRSTHDR(&message);
+      header != NULL;
+      header = CMSG_NXTHDR(&message, header)
+  ) {
+    if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    const auto count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (auto i = 0u; i < count; i++) {
+      int fd;
+      std::memcpy(&fd, CMSG_DATA(header) + i * sizeof(int), sizeof(fd));
+      //! do not handle errors if any
+      ::close(fd);
+    }
+  }
+}
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/syscall.h>)
+constexpr void ForkServer::swap(ForkServer&& other) {
+  std::swap(this->pid_, other.pid_);
+  std::swap(this->socket_, other.socket_);
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_FORK_SERVER_HH__
@@ -43,6 +43,10 @@
 #warning <sys/wait.h> is not found => \
     cu0::Process::stop_code() will not be supported
 #endif
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::Process::create_many() will not be supported
+#endif
 #if !__has_include(<signal.h>)
 #warning <signal.h> is not found => \
     cu0::Process::signal() will not be supported
@@ -50,13 +54,21 @@
     cu0::Process::signal_cautious() will not be supported
 #endif
 
+#include <cstring>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <sstream>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 #if __has_include(<unistd.h>)
 #include <unistd.h>
 #endif
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
 #if __has_include(<sys/types.h>)
 #include <sys/types.h>
 #endif
@@ -67,10 +79,14 @@
 #include <signal.h>
 #endif
 
+#include <cu0/proc/channel.hh>
 #include <cu0/proc/executable.hh>
+#include <cu0/proc/spawn_options.hh>
 
 namespace cu0 {
 
+struct ForkServer;
+
 /*!
  * @brief The Process struct provides a way to access process-specific data
  */
@@ -78,7 +94,8 @@ struct Process {
 public:
 #if __has_include(<unistd.h>)
   /*!
-   * @brief enum of possible errors for create() and create_pipeless() functions
+   * @brief enum of possible errors for create(), create_pipeless() and
+   *     create_many() functions
    */
   enum struct CreateError {
     AGAIN = EAGAIN, //! @see EAGAIN
@@ -87,6 +104,10 @@ public:
     INVAL = EINVAL, //! @see EINVAL
     MFILE = EMFILE, //! @see EMFILE
     NFILE = ENFILE, //! @see ENFILE
+    PERM = EPERM, //! @see EPERM
+    SRCH = ESRCH, //! @see ESRCH
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::vfork() and SpawnOptions::apply()
   };
 #endif
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
@@ -198,6 +219,86 @@ public:
   static std::variant<Process, CreateError> create_pipeless(
       const Executable& executable
   );
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process using the specified executable and applies
+   *     the specified options to it before it runs the executable
+   * @note if the options can not be applied =>
+   *     the executable is not run and the error is returned
+   * @param executable is the excutable to be run by the process
+   * @param options are the options to be applied to the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<Process, CreateError> create(
+      const Executable& executable,
+      const SpawnOptions& options
+  );
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process without pipes using the specified executable and
+   *     applies the specified options to it before it runs the executable
+   * @note if the options can not be applied =>
+   *     the executable is not run and the error is returned
+   * @param executable is the excutable to be run by the process
+   * @param options are the options to be applied to the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<Process, CreateError> create_pipeless(
+      const Executable& executable,
+      const SpawnOptions& options
+  );
+#endif
+#if \
+    __has_include(<unistd.h>) && \
+    __has_include(<fcntl.h>) && \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+  /*!
+   * @brief creates a process using the specified executable and
+   *     shares the specified channel with it
+   * @note the file descriptor of the channel is inherited by the process with
+   *     the same value => pass it to the process, e.g. as an argument,
+   *     for the process to attach to the channel
+   *     @see Channel::fd() @see Channel::attach()
+   * @param executable is the excutable to be run by the process
+   * @param channel is the channel to be shared with the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<Process, CreateError> create(
+      const Executable& executable,
+      const Channel& channel
+  );
+#endif
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+  /*!
+   * @brief creates processes using the specified executables
+   * @note argument and environment vectors of all the executables are
+   *     prepared in one allocation
+   *     and consecutive executables with equal environments share
+   *     an environment vector
+   * @note pipes of a process are created just before the process =>
+   *     3 file descriptors per created process are kept open
+   * @param executables are the executables to be run by the processes
+   * @return vector containing for each executable in the same order
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::vector<std::variant<Process, CreateError>> create_many(
+      std::span<const Executable> executables
+  );
 #endif
   /*!
    * @brief destructs an instance
@@ -344,6 +445,46 @@ public:
   std::tuple<std::variant<std::monostate, ReadError>, std::string>
       stderr_cautious() const;
 #endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief returns the value of the stdout allocated from a memory resource
+   * @param resource is the memory resource of the returned string
+   *     e.g. std::pmr::monotonic_buffer_resource of a request
+   * @return string containing stdout value
+   */
+  [[nodiscard]]
+  std::pmr::string stdout(std::pmr::memory_resource* resource) const;
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief returns the value of the stdout allocated from a memory resource
+   * @param resource is the memory resource of the returned string
+   * @return result of Process::read_from() @see Process::read_from()
+   */
+  [[nodiscard]]
+  std::tuple<std::variant<std::monostate, ReadError>, std::pmr::string>
+      stdout_cautious(std::pmr::memory_resource* resource) const;
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief returns the value of the stderr allocated from a memory resource
+   * @param resource is the memory resource of the returned string
+   *     e.g. std::pmr::monotonic_buffer_resource of a request
+   * @return string containing stderr value
+   */
+  [[nodiscard]]
+  std::pmr::string stderr(std::pmr::memory_resource* resource) const;
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief returns the value of the stderr allocated from a memory resource
+   * @param resource is the memory resource of the returned string
+   * @return result of Process::read_from() @see Process::read_from()
+   */
+  [[nodiscard]]
+  std::tuple<std::variant<std::monostate, ReadError>, std::pmr::string>
+      stderr_cautious(std::pmr::memory_resource* resource) const;
+#endif
 #if __has_include(<signal.h>)
   /*!
    * @brief sends the specified code as a signal to this process
@@ -365,6 +506,53 @@ public:
   ) const;
 #endif
 protected:
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process using the specified executable
+   * @tparam PIPES specifies if stdin, stdout and stderr pipes need to be
+   *     created
+   * @param executable is the excutable to be run by the process
+   * @param options are the options to be applied to the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  template <bool PIPES>
+  [[nodiscard]]
+  static std::variant<Process, CreateError> spawn(
+      const Executable& executable,
+      const SpawnOptions& options
+  );
+#endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief creates a process running the specified argument and environment
+   *     vectors
+   * @tparam PIPES specifies if the specified pipes need to be used as
+   *     stdin, stdout and stderr of the process
+   * @note if PIPES => the pipes are closed
+   *     except the ends owned by the created process
+   * @param argv is the argument vector terminated by NULL
+   * @param envp is the environment vector terminated by NULL
+   * @param in_fd is the stdin pipe
+   * @param out_fd is the stdout pipe
+   * @param err_fd is the stderr pipe
+   * @param options are the options to be applied to the process
+   * @return
+   *     if no error was reported => created process
+   *     else => error code
+   */
+  template <bool PIPES>
+  [[nodiscard]]
+  static std::variant<Process, CreateError> fork_exec(
+      char* const* argv,
+      char* const* envp,
+      const int (&in_fd)[2],
+      const int (&out_fd)[2],
+      const int (&err_fd)[2],
+      const SpawnOptions& options
+  );
+#endif
 #if __has_include(<unistd.h>)
   /*!
    * @brief writes the specified input into the specified pipe
@@ -421,6 +609,35 @@ protected:
   [[nodiscard]]
   static Return read_from(const int& pipe);
 #endif
+#if __has_include(<unistd.h>)
+  /*!
+   * @brief reads all data from the pipe into a string allocated from
+   *     a memory resource
+   * @note data are appended to the string as they are read =>
+   *     no intermediate buffer is allocated
+   * @tparam BUFFER_SIZE is the maximum number of bytes read at once
+   * @tparam Return is the type to be returned by this function
+   * @param pipe is the pipe from which data will be read
+   * @param resource is the memory resource of the returned string
+   * @return
+   *     if Return == std::tuple<
+   *         std::variant<std::monostate, ReadError>,
+   *         std::pmr::string
+   *     > =>
+   *         tuple containing
+   *             variant of
+   *                 if no error was reported => std::monostate
+   *                 else => error code
+   *             data that have been read
+   *     if Return == std::pmr::string => data that have been read
+   */
+  template <std::size_t BUFFER_SIZE, class Return>
+  [[nodiscard]]
+  static Return read_from(
+      const int& pipe,
+      std::pmr::memory_resource* resource
+  );
+#endif
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
   /*!
    * @brief loops to wait for process exit
@@ -465,6 +682,8 @@ protected:
   std::optional<int> stop_code_ = {};
 #endif
 private:
+  //! fork server constructs processes created by its helper process
+  friend struct ForkServer;
 };
 
 } /// namespace cu0
@@ -501,78 +720,7 @@ inline Process Process::current() {
 inline std::variant<Process, typename Process::CreateError> Process::create(
     const Executable& executable
 ) {
-  const auto [argv, argv_size] = util::argv_of(executable);
-  const auto [envp, envp_size] = util::envp_of(executable);
-  auto argv_raw = std::make_unique<char*[]>(argv_size);
-  for (auto i = 0u; i < argv_size; i++) {
-    argv_raw[i] = argv[i].get();
-  }
-  auto envp_raw = std::make_unique<char*[]>(envp_size);
-  for (auto i = 0u; i < envp_size; i++) {
-    envp_raw[i] = envp[i].get();
-  }
-  int in_fd[2];
-  int out_fd[2];
-  int err_fd[2];
-  if (::pipe(in_fd) != 0) {
-    return static_cast<CreateError>(errno);
-  }
-  if (::pipe(out_fd) != 0) {
-    const auto ret = static_cast<CreateError>(errno);
-    //! do not handle errors if any
-    ::close(in_fd[0]);
-    ::close(in_fd[1]);
-    return ret;
-  }
-  if (::pipe(err_fd) != 0) {
-    const auto ret = static_cast<CreateError>(errno);
-    //! do not handle errors if any
-    ::close(in_fd[0]);
-    ::close(in_fd[1]);
-    ::close(out_fd[0]);
-    ::close(out_fd[1]);
-    return ret;
-  }
-  const auto pid = ::vfork();
-  if (pid == 0) { //! forked process
-    {
-      //! do not handle errors if any
-      ::close(in_fd[1]);
-      ::close(out_fd[0]);
-      ::close(err_fd[0]);
-      ::dup2(in_fd[0], STDIN_FILENO);
-      ::dup2(out_fd[1], STDOUT_FILENO);
-      ::dup2(err_fd[1], STDERR_FILENO);
-      ::close(in_fd[0]);
-      ::close(out_fd[1]);
-      ::close(err_fd[1]);
-    }
-    //! `argv_raw` and `envp_raw` will be copied by `::execve`
-    const auto exec_ret = ::execve(argv_raw[0], argv_raw.get(), envp_raw.get());
-    if (exec_ret != 0) {
-      //! exec failed
-      ::_exit(errno);
-    }
-  }
-  {
-    //! do not handle errors if any
-    ::close(in_fd[0]);
-    ::close(out_fd[1]);
-    ::close(err_fd[1]);
-  }
-  if (pid < 0) { //! fork failed
-    //! do not handle errors if any
-    ::close(in_fd[1]);
-    ::close(out_fd[0]);
-    ::close(err_fd[0]);
-    return static_cast<CreateError>(errno);
-  }
-  auto process = Process{};
-  process.pid_ = pid;
-  process.stdin_pipe_ = in_fd[1];
-  process.stdout_pipe_ = out_fd[0];
-  process.stderr_pipe_ = err_fd[0];
-  return process;
+  return Process::spawn<true>(executable, SpawnOptions{});
 }
 #endif
 
@@ -581,31 +729,44 @@ inline std::variant<Process, typename Process::CreateError>
 Process::create_pipeless(
     const Executable& executable
 ) {
-  const auto [argv, argv_size] = util::argv_of(executable);
-  const auto [envp, envp_size] = util::envp_of(executable);
-  auto argv_raw = std::make_unique<char*[]>(argv_size);
-  for (auto i = 0u; i < argv_size; i++) {
-    argv_raw[i] = argv[i].get();
-  }
-  auto envp_raw = std::make_unique<char*[]>(envp_size);
-  for (auto i = 0u; i < envp_size; i++) {
-    envp_raw[i] = envp[i].get();
-  }
-  const auto pid = ::vfork();
-  if (pid == 0) { //! forked process
-    //! `argv_raw` and `envp_raw` will be copied by `::execve`
-    const auto exec_ret = ::execve(argv_raw[0], argv_raw.get(), envp_raw.get());
-    if (exec_ret != 0) {
-      //! exec failed
-      ::_exit(errno);
-    }
-  }
-  if (pid < 0) { //! fork failed
-    return static_cast<CreateError>(errno);
-  }
-  auto process = Process{};
-  process.pid_ = pid;
-  return process;
+  return Process::spawn<false>(executable, SpawnOptions{});
+}
+#endif
+
+#if __has_include(<unistd.h>)
+inline std::variant<Process, typename Process::CreateError> Process::create(
+    const Executable& executable,
+    const SpawnOptions& options
+) {
+  return Process::spawn<true>(executable, options);
+}
+#endif
+
+#if __has_include(<unistd.h>)
+inline std::variant<Process, typename Process::CreateError>
+Process::create_pipeless(
+    const Executable& executable,
+    const SpawnOptions& options
+) {
+  return Process::spawn<false>(executable, options);
+}
+#endif
+
+#if \
+    __has_include(<unistd.h>) && \
+    __has_include(<fcntl.h>) && \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/mman.h>) && \
+    __has_include(<sys/syscall.h>)
+inline std::variant<Process, typename Process::CreateError> Process::create(
+    const Executable& executable,
+    const Channel& channel
+) {
+  //! the file table of the created process is not shared =>
+  //!     only the created process inherits the file descriptor
+  return Process::spawn<true>(executable, SpawnOptions{
+    .descriptors = { { channel.fd(), channel.fd(), }, },
+  });
 }
 #endif
 
@@ -742,6 +903,52 @@ inline std::tuple<
 }
 #endif
 
+#if __has_include(<unistd.h>)
+inline std::pmr::string Process::stdout(
+    std::pmr::memory_resource* resource
+) const {
+  return Process::read_from<1024, std::pmr::string>(
+      this->stdout_pipe_,
+      resource
+  );
+}
+#endif
+
+#if __has_include(<unistd.h>)
+inline std::tuple<
+    std::variant<std::monostate, typename Process::ReadError>,
+    std::pmr::string
+> Process::stdout_cautious(std::pmr::memory_resource* resource) const {
+  return Process::read_from<
+      1024,
+      std::tuple<std::variant<std::monostate, ReadError>, std::pmr::string>
+  >(this->stdout_pipe_, resource);
+}
+#endif
+
+#if __has_include(<unistd.h>)
+inline std::pmr::string Process::stderr(
+    std::pmr::memory_resource* resource
+) const {
+  return Process::read_from<1024, std::pmr::string>(
+      this->stderr_pipe_,
+      resource
+  );
+}
+#endif
+
+#if __has_include(<unistd.h>)
+inline std::tuple<
+    std::variant<std::monostate, typename Process::ReadError>,
+    std::pmr::string
+> Process::stderr_cautious(std::pmr::memory_resource* resource) const {
+  return Process::read_from<
+      1024,
+      std::tuple<std::variant<std::monostate, ReadError>, std::pmr::string>
+  >(this->stderr_pipe_, resource);
+}
+#endif
+
 #if __has_include(<signal.h>)
 inline void Process::signal(const int& code) const {
   ::kill(this->pid_, code);
@@ -760,6 +967,290 @@ Process::signal_cautious(
 }
 #endif
 
+#if __has_include(<unistd.h>)
+template <bool PIPES>
+inline std::variant<Process, typename Process::CreateError> Process::spawn(
+    const Executable& executable,
+    const SpawnOptions& options
+) {
+  auto* resource = options.resource != nullptr ?
+      options.resource :
+      std::pmr::get_default_resource();
+  //! strings of each vector are allocated at once
+  const auto [argv_strings, argv] = util::argv_of(executable, resource);
+  //! a block is formatted already and an overlay refers to existing
+  //!     strings => nothing to format
+  const auto formatted =
+      options.environment_block.has_value() ||
+      options.environment.has_value();
+  auto [envp_strings, envp] = formatted ?
+      std::make_tuple(
+          std::pmr::vector<char>{resource},
+          std::pmr::vector<char*>{resource}
+      ) :
+      util::envp_of(executable, resource);
+  if (options.environment_block.has_value()) {
+    //! the block outlives the process creation => not copied
+  } else if (options.environment.has_value()) {
+    envp = options.environment.value().envp(resource);
+  }
+  int in_fd[2] = { -1, -1, };
+  int out_fd[2] = { -1, -1, };
+  int err_fd[2] = { -1, -1, };
+  if constexpr (PIPES) {
+    if (::pipe(in_fd) != 0) {
+      return static_cast<CreateError>(errno);
+    }
+    if (::pipe(out_fd) != 0) {
+      const auto ret = static_cast<CreateError>(errno);
+      //! do not handle errors if any
+      ::close(in_fd[0]);
+      ::close(in_fd[1]);
+      return ret;
+    }
+    if (::pipe(err_fd) != 0) {
+      const auto ret = static_cast<CreateError>(errno);
+      //! do not handle errors if any
+      ::close(in_fd[0]);
+      ::close(in_fd[1]);
+      ::close(out_fd[0]);
+      ::close(out_fd[1]);
+      return ret;
+    }
+  }
+  return Process::fork_exec<PIPES>(
+      argv.data(),
+      options.environment_block.has_value() ?
+          options.environment_block.value().envp() :
+          envp.data(),
+      in_fd,
+      out_fd,
+      err_fd,
+      options
+  );
+}
+#endif
+
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+inline std::vector<std::variant<Process, typename Process::CreateError>>
+Process::create_many(
+    const std::span<const Executable> executables
+) {
+  //! the first pass computes the size of the arena
+  //!     where all argument and environment strings are stored
+  auto strings_size = std::size_t{0};
+  auto pointers_size = std::size_t{0};
+  for (auto i = 0u; i < executables.size(); i++) {
+    const auto& executable = executables[i];
+    //! argv == executable.binary + executable.arguments + NULL
+    strings_size += executable.binary.native().size() + 1;
+    for (const auto& argument : executable.arguments) {
+      strings_size += argument.size() + 1;
+    }
+    pointers_size += 1 + executable.arguments.size() + 1;
+    //! the same environment as the one of the previous executable =>
+    //!     the previous envp is reused
+    if (
+        i != 0 &&
+        executable.environment == executables[i - 1].environment
+    ) {
+      continue;
+    }
+    //! envp == formatted(executable.environment) + NULL
+    for (const auto& [key, value] : executable.environment) {
+      strings_size += key.size() + 1 + value.size() + 1;
+    }
+    pointers_size += executable.environment.size() + 1;
+  }
+  auto strings = std::make_unique<char[]>(strings_size);
+  auto pointers = std::make_unique<char*[]>(pointers_size);
+  //! the second pass fills the arena
+  auto vectors = std::vector<std::tuple<char**, char**>>{};
+  vectors.reserve(executables.size());
+  auto string = strings.get();
+  auto pointer = pointers.get();
+  const auto append = [&string](const std::string_view& data) {
+    std::memcpy(string, data.data(), data.size());
+    string += data.size();
+  };
+  for (auto i = 0u; i < executables.size(); i++) {
+    const auto& executable = executables[i];
+    const auto argv = pointer;
+    *pointer++ = string;
+    append(executable.binary.native());
+    *string++ = '\0';
+    for (const auto& argument : executable.arguments) {
+      *pointer++ = string;
+      append(argument);
+      *string++ = '\0';
+    }
+    *pointer++ = NULL;
+    if (
+        i != 0 &&
+        executable.environment == executables[i - 1].environment
+    ) {
+      vectors.emplace_back(argv, std::get<1>(vectors.back()));
+      continue;
+    }
+    const auto envp = pointer;
+    for (const auto& [key, value] : executable.environment) {
+      *pointer++ = string;
+      append(key);
+      *string++ = '=';
+      append(value);
+      *string++ = '\0';
+    }
+    *pointer++ = NULL;
+    vectors.emplace_back(argv, envp);
+  }
+  //! pipes of a process are created just before it is created and the
+  //!     ends of the process are closed by the parent afterwards =>
+  //!     3 descriptors per process are kept instead of 6 per executable
+  //! pipes are created with O_CLOEXEC for a process not to inherit pipes of
+  //!     other processes
+  //! ::dup2() clears O_CLOEXEC of stdin, stdout and stderr of a process
+  auto ret = std::vector<std::variant<Process, CreateError>>{};
+  ret.reserve(executables.size());
+  for (auto i = 0u; i < executables.size(); i++) {
+    int in_fd[2] = { -1, -1, };
+    int out_fd[2] = { -1, -1, };
+    int err_fd[2] = { -1, -1, };
+    if (
+        ::pipe2(in_fd, O_CLOEXEC) != 0 ||
+        ::pipe2(out_fd, O_CLOEXEC) != 0 ||
+        ::pipe2(err_fd, O_CLOEXEC) != 0
+    ) {
+      ret.emplace_back(static_cast<CreateError>(errno));
+      //! do not handle errors if any
+      for (const auto& fd : { in_fd[0], in_fd[1], out_fd[0], out_fd[1], }) {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+      }
+      continue;
+    }
+    const auto& [argv, envp] = vectors[i];
+    ret.push_back(Process::fork_exec<true>(
+        argv,
+        envp,
+        in_fd,
+        out_fd,
+        err_fd,
+        SpawnOptions{}
+    ));
+  }
+  return ret;
+}
+#endif
+
+#if __has_include(<unistd.h>)
+template <bool PIPES>
+inline std::variant<Process, typename Process::CreateError> Process::fork_exec(
+    char* const* argv,
+    char* const* envp,
+    [[maybe_unused]] const int (&in_fd)[2],
+    [[maybe_unused]] const int (&out_fd)[2],
+    [[maybe_unused]] const int (&err_fd)[2],
+    const SpawnOptions& options
+) {
+  //! the forked process must not allocate =>
+  //!     the storage for the duplicated descriptors is allocated here
+#if __has_include(<fcntl.h>)
+  auto staged = std::pmr::vector<int>(
+      options.descriptors.size(),
+      options.resource != nullptr ?
+          options.resource :
+          std::pmr::get_default_resource()
+  );
+#else
+  auto staged = std::pmr::vector<int>{};
+#endif
+  //! the memory of this process is shared with the forked process until
+  //!     the forked process runs the executable or exits =>
+  //!     the forked process reports an error by setting this value
+  volatile int failure = 0;
+  const auto pid = ::vfork();
+  if (pid == 0) { //! forked process
+    if constexpr (PIPES) {
+      //! do not handle errors if any
+      ::close(in_fd[1]);
+      ::close(out_fd[0]);
+      ::close(err_fd[0]);
+      ::dup2(in_fd[0], STDIN_FILENO);
+      ::dup2(out_fd[1], STDOUT_FILENO);
+      ::dup2(err_fd[1], STDERR_FILENO);
+      ::close(in_fd[0]);
+      ::close(out_fd[1]);
+      ::close(err_fd[1]);
+    }
+    if (const auto error = options.apply(staged); error != 0) {
+      failure = error;
+      ::_exit(error);
+    }
+    //! `argv` and `envp` will be copied by `::execve`
+#if __has_include(<fcntl.h>) && __has_include(<sys/syscall.h>)
+    const auto exec_ret = options.binary.has_value() ?
+        //! the binary is not looked up by its path
+        static_cast<int>(::syscall(
+            SYS_execveat,
+            options.binary.value(),
+            "",
+            argv,
+            envp,
+            AT_EMPTY_PATH
+        )) :
+        ::execve(argv[0], argv, envp);
+#else
+    const auto exec_ret = ::execve(argv[0], argv, envp);
+#endif
+    if (exec_ret != 0) {
+      //! exec failed
+      ::_exit(errno);
+    }
+  }
+  if (pid < 0) { //! fork failed
+    const auto ret = static_cast<CreateError>(errno);
+    if constexpr (PIPES) {
+      //! do not handle errors if any
+      ::close(in_fd[0]);
+      ::close(in_fd[1]);
+      ::close(out_fd[0]);
+      ::close(out_fd[1]);
+      ::close(err_fd[0]);
+      ::close(err_fd[1]);
+    }
+    return ret;
+  }
+  if constexpr (PIPES) {
+    //! do not handle errors if any
+    ::close(in_fd[0]);
+    ::close(out_fd[1]);
+    ::close(err_fd[1]);
+  }
+  if (failure != 0) { //! options were not applied
+    if constexpr (PIPES) {
+      //! do not handle errors if any
+      ::close(in_fd[1]);
+      ::close(out_fd[0]);
+      ::close(err_fd[0]);
+    }
+#if __has_include(<sys/wait.h>)
+    //! the forked process has exited => wait for it not to leave a zombie
+    while (::waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {}
+#endif
+    return static_cast<CreateError>(failure);
+  }
+  auto process = Process{};
+  process.pid_ = pid;
+  if constexpr (PIPES) {
+    process.stdin_pipe_ = in_fd[1];
+    process.stdout_pipe_ = out_fd[0];
+    process.stderr_pipe_ = err_fd[0];
+  }
+  return process;
+}
+#endif
+
 #if __has_include(<unistd.h>)
 template <std::size_t BUFFER_SIZE, class Return>
 Return Process::write_into(
@@ -852,6 +1343,43 @@ inline Return Process::read_from(const int& pipe) {
 }
 #endif
 
+#if __has_include(<unistd.h>)
+template <std::size_t BUFFER_SIZE, class Return>
+inline Return Process::read_from(
+    const int& pipe,
+    std::pmr::memory_resource* resource
+) {
+  using non_void_return_type =
+      std::tuple<std::variant<std::monostate, ReadError>, std::pmr::string>;
+  static_assert(
+      std::is_same_v<Return, std::pmr::string> ||
+      std::is_same_v<Return, non_void_return_type>
+  );
+  auto ret = std::pmr::string{resource};
+  ssize_t bytes;
+  do {
+    //! data are read directly into the string
+    const auto size = ret.size();
+    ret.resize(size + BUFFER_SIZE);
+    bytes = ::read(pipe, ret.data() + size, BUFFER_SIZE);
+    ret.resize(size + (bytes < 0 ? 0 : bytes));
+    if (bytes < 0) { //! read failed
+      if constexpr (std::is_same_v<Return, std::pmr::string>) {
+        return ret;
+      } else { //! std::is_same_v<Return, non_void_return_type>
+        return { static_cast<ReadError>(errno), std::move(ret), };
+      }
+    }
+    //! a short read ends the data as in read_from(const int&)
+  } while (bytes == BUFFER_SIZE);
+  if constexpr (std::is_same_v<Return, std::pmr::string>) {
+    return ret;
+  } else { //! std::is_same_v<Return, non_void_return_type>
+    return { std::monostate{}, std::move(ret), };
+  }
+}
+#endif
+
 #if __has_include(<sys/types.h>) && __has_include(<sys/wait.h>)
 template <class Return>
 inline Return Process::wait_exit_loop() {
@@ -0,0 +1,340 @@
+#ifndef CU0_REAPER_HH__
+#define CU0_REAPER_HH__
+
+#if !__has_include(<poll.h>)
+#warning <poll.h> is not found => \
+    cu0::Reaper will not be supported
+#endif
+#if !__has_include(<sys/eventfd.h>)
+#warning <sys/eventfd.h> is not found => \
+    cu0::Reaper will not be supported
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::Reaper will not be supported
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#if __has_include(<poll.h>)
+#include <poll.h>
+#endif
+#if __has_include(<sys/eventfd.h>)
+#include <sys/eventfd.h>
+#endif
+#if __has_include(<sys/syscall.h>)
+#include <sys/syscall.h>
+#endif
+
+#include <cu0/proc/process.hh>
+
+namespace cu0 {
+
+#if \
+    __has_include(<poll.h>) && \
+    __has_include(<sys/eventfd.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+/*!
+ * @brief The Reaper struct provides a way to create processes which are waited
+ *     automatically, i.e. which do not need to be tracked by the caller and
+ *     do not remain zombies after they exit
+ * @note processes are waited by a thread of the reaper which is started when
+ *     the reaper is accessed for the first time @see Reaper::instance()
+ * @note processes are watched with pidfd => Linux 5.3 or newer is required
+ * @note if the pidfds can not be polled, e.g. there are more of them than
+ *     RLIMIT_NOFILE => the processes are checked by ::waitid() periodically
+ */
+struct Reaper {
+public:
+  /*!
+   * @brief enum of possible errors for adopt() function
+   */
+  enum struct AdoptError {
+    INVAL = EINVAL, //! @see EINVAL
+    MFILE = EMFILE, //! @see EMFILE
+    NFILE = ENFILE, //! @see ENFILE
+    NODEV = ENODEV, //! @see ENODEV
+    NOMEM = ENOMEM, //! @see ENOMEM
+    NOSYS = ENOSYS, //! @see ENOSYS
+    SRCH = ESRCH, //! @see ESRCH
+    //! it is possible that a value is not listed in this enum =>
+    //!     for other error codes @see ::pidfd_open()
+  };
+  /*!
+   * @brief type of a function called after a process is waited
+   * @note called by the thread of the reaper => must not throw and
+   *     should return quickly
+   * @param process is the waited process @see Process::exit_code()
+   *     @see Process::termination_code()
+   */
+  using Callback = std::function<void(const Process& process)>;
+  /*!
+   * @brief accesses the reaper, the thread of the reaper is started on the
+   *     first call
+   * @return reaper as a mutable reference
+   */
+  [[nodiscard]]
+  static Reaper& instance();
+  /*!
+   * @brief destructs an instance
+   * @note the thread of the reaper is stopped, processes which have not been
+   *     waited yet are waited by init after this process exits
+   */
+  virtual ~Reaper();
+  constexpr Reaper(const Reaper& other) = delete;
+  constexpr Reaper& operator =(const Reaper& other) = delete;
+  constexpr Reaper(Reaper&& other) = delete;
+  constexpr Reaper& operator =(Reaper&& other) = delete;
+  /*!
+   * @brief creates a process without pipes using the specified executable
+   *     and passes it to the reaper @see Reaper::adopt()
+   * @note if the process can not be adopted => the process is killed and
+   *     the error is returned
+   * @param executable is the excutable to be run by the process
+   * @param on_exit is the function called after the process is waited
+   *     if empty => nothing is called
+   * @return
+   *     if no error was reported => process identifier of the created process
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<unsigned, Process::CreateError> create(
+      const Executable& executable,
+      Callback on_exit = {}
+  );
+  /*!
+   * @brief passes the specified process to the reaper to be waited
+   * @note the process is not moved if an error is reported
+   * @param process is the process to be waited
+   * @param on_exit is the function called after the process is waited
+   *     if empty => nothing is called
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  [[nodiscard]]
+  std::variant<std::monostate, AdoptError> adopt(
+      Process&& process,
+      Callback on_exit = {}
+  );
+  /*!
+   * @brief accesses the number of adopted processes which have not been
+   *     waited yet
+   * @return number of processes
+   */
+  [[nodiscard]]
+  std::size_t pending() const;
+protected:
+  //! process watched by the reaper
+  struct Entry {
+    //! process to be waited
+    Process process;
+    //! function called after the process is waited
+    Callback on_exit;
+    //! file descriptor referring to the process
+    int pidfd;
+  };
+  //! interval between checks of the processes if the pidfds can not be
+  //!     polled
+  static constexpr auto FALLBACK_INTERVAL = std::chrono::milliseconds{100};
+  /*!
+   * @brief constructs an instance and starts the thread of the reaper
+   */
+  Reaper();
+  /*!
+   * @brief waits for adopted processes until the reaper is destructed
+   */
+  void run();
+  //! guards adopted_ and stopping_
+  std::mutex mutex_;
+  //! processes adopted but not yet watched by the thread of the reaper
+  std::vector<Entry> adopted_;
+  //! true if the thread of the reaper needs to stop
+  bool stopping_ = false;
+  //! number of adopted processes which have not been waited yet
+  std::atomic<std::size_t> pending_ = 0;
+  //! event file descriptor to wake the thread of the reaper up
+  int event_ = -1;
+  //! thread of the reaper
+  std::thread thread_;
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if \
+    __has_include(<poll.h>) && \
+    __has_include(<sys/eventfd.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<sys/types.h>) && \
+    __has_include(<sys/wait.h>)
+inline Reaper& Reaper::instance() {
+  static auto reaper = Reaper{};
+  return reaper;
+}
+
+inline Reaper::~Reaper() {
+  {
+    const auto lock = std::lock_guard{this->mutex_};
+    this->stopping_ = true;
+  }
+  //! do not handle errors if any
+  ::eventfd_write(this->event_, 1);
+  if (this->thread_.joinable()) {
+    this->thread_.join();
+  }
+  for (const auto& entry : this->adopted_) {
+    ::close(entry.pidfd);
+  }
+  ::close(this->event_);
+}
+
+inline std::variant<unsigned, typename Process::CreateError> Reaper::create(
+    const Executable& executable,
+    Callback on_exit
+) {
+  auto created = Process::create_pipeless(executable);
+  if (std::holds_alternative<Process::CreateError>(created)) {
+    return std::get<Process::CreateError>(created);
+  }
+  auto& process = std::get<Process>(created);
+  const auto pid = process.pid();
+  const auto adopted = this->adopt(std::move(process), std::move(on_exit));
+  if (std::holds_alternative<AdoptError>(adopted)) {
+    //! do not leave a process which nobody waits for
+    process.signal(SIGKILL);
+    process.wait();
+    return static_cast<Process::CreateError>(std::get<AdoptError>(adopted));
+  }
+  return pid;
+}
+
+inline std::variant<std::monostate, typename Reaper::AdoptError> Reaper::adopt(
+    Process&& process,
+    Callback on_exit
+) {
+  //! a process which has exited but has not been waited yet can be opened too
+  //! pidfd is opened with O_CLOEXEC
+  const auto pidfd = static_cast<int>(
+      ::syscall(SYS_pidfd_open, process.pid(), 0)
+  );
+  if (pidfd < 0) {
+    return static_cast<AdoptError>(errno);
+  }
+  {
+    const auto lock = std::lock_guard{this->mutex_};
+    this->pending_++;
+    this->adopted_.push_back(Entry{
+      .process = std::move(process),
+      .on_exit = std::move(on_exit),
+      .pidfd = pidfd,
+    });
+  }
+  //! do not handle errors if any
+  ::eventfd_write(this->event_, 1);
+  return std::monostate{};
+}
+
+inline std::size_t Reaper::pending() const {
+  return this->pending_;
+}
+
+inline Reaper::Reaper()
+    : event_{::eventfd(0, EFD_CLOEXEC)}, thread_{&Reaper::run, this} {}
+
+inline void Reaper::run() {
+  auto watched = std::vector<Entry>{};
+  auto fds = std::vector<::pollfd>{};
+  while (true) {
+    fds.clear();
+    fds.push_back({ .fd = this->event_, .events = POLLIN, .revents = 0, });
+    for (const auto& entry : watched) {
+      fds.push_back({ .fd = entry.pidfd, .events = POLLIN, .revents = 0, });
+    }
+    if (::poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      //! too many pidfds for RLIMIT_NOFILE or no memory =>
+      //!     only the event file descriptor is polled with a timeout not to
+      //!     busy-loop, and the processes are checked by ::waitid()
+      fds[0].revents = 0;
+      auto event = ::pollfd{
+        .fd = this->event_,
+        .events = POLLIN,
+        .revents = 0,
+      };
+      if (
+          ::poll(
+              &event,
+              1,
+              static_cast<int>(Reaper::FALLBACK_INTERVAL.count())
+          ) > 0
+      ) {
+        fds[0].revents = event.revents;
+      }
+      for (auto i = 0u; i < watched.size(); i++) {
+        auto info = ::siginfo_t{};
+        //! WNOWAIT => the process is waited below as if its pidfd was polled
+        const auto checked = ::waitid(
+            P_PID,
+            watched[i].process.pid(),
+            &info,
+            WEXITED | WNOHANG | WNOWAIT
+        );
+        //! ECHILD => the process has been waited elsewhere
+        const auto exited =
+            (checked == 0 && info.si_pid != 0) ||
+            (checked != 0 && errno == ECHILD);
+        fds[i + 1].revents = exited ? POLLIN : 0;
+      }
+    }
+    //! a pidfd is readable when its process exits
+    for (auto i = watched.size(); i > 0; i--) {
+      if (fds[i].revents == 0) {
+        continue;
+      }
+      auto& entry = watched[i - 1];
+      entry.process.wait();
+      if (entry.on_exit) {
+        entry.on_exit(entry.process);
+      }
+      ::close(entry.pidfd);
+      watched.erase(watched.begin() + (i - 1));
+      this->pending_--;
+    }
+    if (fds[0].revents != 0) {
+      auto value = ::eventfd_t{};
+      //! do not handle errors if any
+      ::eventfd_read(this->event_, &value);
+      const auto lock = std::lock_guard{this->mutex_};
+      for (auto& entry : this->adopted_) {
+        watched.push_back(std::move(entry));
+      }
+      this->adopted_.clear();
+      if (this->stopping_) {
+        break;
+      }
+    }
+  }
+  for (const auto& entry : watched) {
+    ::close(entry.pidfd);
+  }
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_REAPER_HH__
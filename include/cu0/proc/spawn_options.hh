@@ -0,0 +1,343 @@
+#ifndef CU0_SPAWN_OPTIONS_HH__
+#define CU0_SPAWN_OPTIONS_HH__
+
+#if !__has_include(<sched.h>)
+#warning <sched.h> is not found => \
+    cu0::SpawnOptions::affinity will not be supported
+#warning <sched.h> is not found => \
+    cu0::SpawnOptions::policy will not be supported
+#endif
+#if !__has_include(<sys/resource.h>)
+#warning <sys/resource.h> is not found => \
+    cu0::SpawnOptions::nice will not be supported
+#warning <sys/resource.h> is not found => \
+    cu0::SpawnOptions::address_space will not be supported
+#warning <sys/resource.h> is not found => \
+    cu0::SpawnOptions::cpu_time will not be supported
+#warning <sys/resource.h> is not found => \
+    cu0::SpawnOptions::open_files will not be supported
+#endif
+#if !__has_include(<fcntl.h>)
+#warning <fcntl.h> is not found => \
+    cu0::SpawnOptions::cgroup will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::SpawnOptions::descriptors will not be supported
+#warning <fcntl.h> is not found => \
+    cu0::SpawnOptions::close_others will not be supported
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::SpawnOptions::io_priority will not be supported
+#warning <sys/syscall.h> is not found => \
+    cu0::SpawnOptions::binary will not be supported
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if __has_include(<fcntl.h>)
+#include <fcntl.h>
+#endif
+#if __has_include(<sched.h>)
+#include <sched.h>
+#endif
+#if __has_include(<sys/resource.h>)
+#include <sys/resource.h>
+#endif
+#if __has_include(<sys/syscall.h>)
+#include <sys/syscall.h>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/env/environment_block.hh>
+#include <cu0/env/environment_overlay.hh>
+
+namespace cu0 {
+
+/*!
+ * @brief The SpawnOptions struct represents attributes which are applied to
+ *     a created process before it runs its executable
+ * @note an empty attribute is inherited from the creating process
+ * @see Process::create(const Executable&, const SpawnOptions&)
+ */
+struct SpawnOptions {
+public:
+#if __has_include(<sched.h>)
+  //! available scheduling policies of a process
+  enum struct Policy {
+    OTHER = SCHED_OTHER, //! @see SCHED_OTHER
+    BATCH = SCHED_BATCH, //! @see SCHED_BATCH
+    IDLE = SCHED_IDLE, //! @see SCHED_IDLE
+  };
+#endif
+#if __has_include(<sys/syscall.h>)
+  //! available I/O scheduling classes of a process @see ioprio_set(2)
+  enum struct IoClass {
+    REALTIME = 1, //! @see IOPRIO_CLASS_RT
+    BEST_EFFORT = 2, //! @see IOPRIO_CLASS_BE
+    IDLE = 3, //! @see IOPRIO_CLASS_IDLE
+  };
+#endif
+#if __has_include(<sys/syscall.h>)
+  //! I/O priority data representation
+  struct IoPriority {
+    IoClass io_class = IoClass::BEST_EFFORT;
+    //! from 0 (the highest priority) to 7 (the lowest priority)
+    //! @note ignored for IoClass::IDLE
+    int level = 4;
+  };
+#endif
+#if __has_include(<sched.h>)
+  //! CPUs on which the process is allowed to run
+  std::optional<cpu_set_t> affinity{};
+  //! scheduling policy of the process
+  std::optional<Policy> policy{};
+#endif
+#if __has_include(<sys/resource.h>)
+  //! nice value of the process
+  //! @note lowering the nice value requires CAP_SYS_NICE
+  std::optional<int> nice{};
+#endif
+#if __has_include(<sys/syscall.h>)
+  //! I/O priority of the process
+  std::optional<IoPriority> io_priority{};
+#endif
+#if __has_include(<sys/resource.h>)
+  //! limits of the virtual memory of the process in bytes @see RLIMIT_AS
+  std::optional<rlimit> address_space{};
+  //! limits of the cpu time of the process in seconds @see RLIMIT_CPU
+  std::optional<rlimit> cpu_time{};
+  //! limits of the file descriptor number of the process @see RLIMIT_NOFILE
+  std::optional<rlimit> open_files{};
+#endif
+#if __has_include(<fcntl.h>)
+  //! file descriptor of a cgroup v2 directory into which the process is placed
+  //!     @see Cgroup::fd()
+  //! @note the file descriptor needs to stay open until the process is created
+  std::optional<int> cgroup{};
+#endif
+#if __has_include(<fcntl.h>)
+  //! file descriptors inherited by the process in the form
+  //!     <file descriptor of this process, file descriptor of the process>
+  //! @note a file descriptor of the process may be equal to
+  //!     a file descriptor of this process of another pair
+  std::vector<std::pair<int, int>> descriptors{};
+  //! if true => file descriptors other than stdin, stdout, stderr and
+  //!     the descriptors are not inherited by the process
+  //! else => file descriptors without FD_CLOEXEC are inherited too
+  bool close_others = false;
+#endif
+#if __has_include(<fcntl.h>) && __has_include(<sys/syscall.h>)
+  //! file descriptor of the binary run by the process instead of
+  //!     Executable::binary @see ExecutableHandle::fd()
+  //! @note Executable::binary is still passed to the process as argv[0]
+  std::optional<int> binary{};
+#endif
+  //! environment of the process used instead of Executable::environment
+  //! @note serialized without copying the base environment
+  std::optional<EnvironmentOverlay> environment{};
+  //! formatted environment of the process used instead of
+  //!     Executable::environment and environment
+  //! @note shared by copies => not formatted again for each process
+  std::optional<EnvironmentBlock> environment_block{};
+  //! memory resource from which the argument and environment vectors are
+  //!     allocated when the process is created
+  //!     e.g. std::pmr::monotonic_buffer_resource of a request
+  //! @note if NULL => std::pmr::get_default_resource() is used
+  std::pmr::memory_resource* resource = nullptr;
+  /*!
+   * @brief applies the attributes to the calling process
+   * @note only async-signal-safe functions are called =>
+   *     can be called by a forked process before exec
+   * @param staged is the storage for the numbers of the duplicated
+   *     descriptors, allocated before fork
+   *     if smaller than descriptors => EINVAL is returned
+   * @return
+   *     if no error was reported => 0
+   *     else => error code
+   */
+  [[nodiscard]]
+  int apply(std::span<int> staged = {}) const;
+protected:
+#if __has_include(<fcntl.h>)
+  /*!
+   * @brief duplicates the descriptors and marks other file descriptors with
+   *     FD_CLOEXEC if close_others
+   * @note only async-signal-safe functions are called
+   * @param staged is the storage for the numbers of the duplicated
+   *     descriptors
+   * @return
+   *     if no error was reported => 0
+   *     else => error code
+   */
+  [[nodiscard]]
+  int inherit(std::span<int> staged) const;
+#endif
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+inline int SpawnOptions::apply(std::span<int> staged) const {
+#if __has_include(<fcntl.h>)
+  //! the process is placed into the cgroup first for the cgroup to account
+  //!     all the resources used by the executable
+  if (this->cgroup.has_value()) {
+    const auto procs = ::openat(
+        this->cgroup.value(),
+        "cgroup.procs",
+        O_WRONLY | O_CLOEXEC
+    );
+    if (procs < 0) {
+      return errno;
+    }
+    //! "0" is the process which writes
+    const auto written = ::write(procs, "0", 1);
+    const auto error = errno;
+    //! do not handle errors if any
+    ::close(procs);
+    if (written != 1) {
+      return error;
+    }
+  }
+#endif
+#if __has_include(<fcntl.h>)
+  if (const auto error = this->inherit(staged); error != 0) {
+    return error;
+  }
+#endif
+#if __has_include(<sched.h>)
+  if (
+      this->affinity.has_value() &&
+      ::sched_setaffinity(0, sizeof(cpu_set_t), &this->affinity.value()) != 0
+  ) {
+    return errno;
+  }
+  if (this->policy.has_value()) {
+    //! SCHED_OTHER, SCHED_BATCH and SCHED_IDLE require 0 static priority
+    const auto parameters = sched_param{ .sched_priority = 0, };
+    if (
+        ::sched_setscheduler(
+            0,
+            static_cast<int>(this->policy.value()),
+            &parameters
+        ) != 0
+    ) {
+      return errno;
+    }
+  }
+#endif
+#if __has_include(<sys/resource.h>)
+  if (
+      this->nice.has_value() &&
+      ::setpriority(PRIO_PROCESS, 0, this->nice.value()) != 0
+  ) {
+    return errno;
+  }
+#endif
+#if __has_include(<sys/syscall.h>)
+  if (this->io_priority.has_value()) {
+    //! glibc does not provide ioprio_set() =>
+    //!     constants of <linux/ioprio.h> are used
+    constexpr auto IOPRIO_WHO_PROCESS = 1;
+    constexpr auto IOPRIO_CLASS_SHIFT = 13;
+    const auto& io_priority = this->io_priority.value();
+    const auto value =
+        static_cast<int>(io_priority.io_class) << IOPRIO_CLASS_SHIFT |
+        (io_priority.io_class == IoClass::IDLE ? 0 : io_priority.level);
+    if (::syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, value) != 0) {
+      return errno;
+    }
+  }
+#endif
+#if __has_include(<sys/resource.h>)
+  if (
+      this->address_space.has_value() &&
+      ::setrlimit(RLIMIT_AS, &this->address_space.value()) != 0
+  ) {
+    return errno;
+  }
+  if (
+      this->cpu_time.has_value() &&
+      ::setrlimit(RLIMIT_CPU, &this->cpu_time.value()) != 0
+  ) {
+    return errno;
+  }
+  if (
+      this->open_files.has_value() &&
+      ::setrlimit(RLIMIT_NOFILE, &this->open_files.value()) != 0
+  ) {
+    return errno;
+  }
+#endif
+  return 0;
+}
+
+#if __has_include(<fcntl.h>)
+inline int SpawnOptions::inherit(std::span<int> staged) const {
+  if (this->descriptors.empty() && !this->close_others) {
+    return 0;
+  }
+  if (staged.size() < this->descriptors.size()) {
+    return EINVAL;
+  }
+  //! the descriptors are duplicated above all the specified file descriptors
+  //!     first for a file descriptor of the process not to overwrite
+  //!     a file descriptor of this process of another pair
+  //! F_DUPFD takes the lowest free file descriptor =>
+  //!     inherited file descriptors above them are not overwritten
+  auto first = 3;
+  for (const auto& [from, to] : this->descriptors) {
+    first = std::max({first, from + 1, to + 1});
+  }
+#if __has_include(<sys/syscall.h>)
+  //! the binary is needed until exec
+  if (this->binary.has_value()) {
+    first = std::max(first, this->binary.value() + 1);
+  }
+#endif
+  for (auto i = 0u; i < this->descriptors.size(); i++) {
+    staged[i] = ::fcntl(this->descriptors[i].first, F_DUPFD, first);
+    if (staged[i] < 0) {
+      return errno;
+    }
+  }
+  if (this->close_others) {
+    //! file descriptors are marked with FD_CLOEXEC instead of being closed
+    //!     for them to be closed by exec at once
+#if defined(CLOSE_RANGE_CLOEXEC)
+    if (::close_range(3, ~0u, CLOSE_RANGE_CLOEXEC) != 0)
+#endif
+    {
+      //! close_range() is not supported => mark one by one
+      const auto max = ::sysconf(_SC_OPEN_MAX);
+      for (auto fd = 3; fd < max; fd++) {
+        //! not opened file descriptors are skipped by errors
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+      }
+    }
+  }
+  for (auto i = 0u; i < this->descriptors.size(); i++) {
+    //! the duplicated file descriptor does not have FD_CLOEXEC
+    if (::dup2(staged[i], this->descriptors[i].second) < 0) {
+      return errno;
+    }
+    //! do not handle errors if any
+    ::close(staged[i]);
+  }
+  return 0;
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_SPAWN_OPTIONS_HH__
@@ -49,6 +49,16 @@ cu0::Strand::allocate_stack(std::size_t) will not be supported
 #warning <pthread.h> is not found => \
 cu0::Strand::deallocate_stack() will not be supported
 #endif
+#if !__has_include(<pthread.h>) || !__has_include(<sched.h>)
+#warning <pthread.h> or <sched.h> is not found => \
+cu0::Strand::GetAffinityError will not be supported
+#warning <pthread.h> or <sched.h> is not found => \
+cu0::Strand::SetAffinityError will not be supported
+#warning <pthread.h> or <sched.h> is not found => \
+cu0::Strand::affinity() will not be supported
+#warning <pthread.h> or <sched.h> is not found => \
+cu0::Strand::affinity(const cpu_set_t&) will not be supported
+#endif
 #if !__has_include(<stdlib.h>)
 #warning <stdlib.h> is not found => \
 cu0::Strand::allocate_stack(std::size_t) will not be supported
@@ -62,7 +72,6 @@ cu0::Strand::allocate_stack(std::size_t) will not be supported
 cu0::Strand::deallocate_stack() will not be supported
 #endif
 
-#include <functional>
 #include <utility>
 #include <variant>
 
@@ -73,6 +82,10 @@ cu0::Strand::deallocate_stack() will not be supported
   #include <thread>
 #endif
 
+#if __has_include(<sched.h>)
+  #include <sched.h>
+#endif
+
 #if __has_include(<stdlib.h>)
   #include <stdlib.h>
 #endif
@@ -81,6 +94,8 @@ cu0::Strand::deallocate_stack() will not be supported
   #include <unistd.h>
 #endif
 
+#include <cu0/proc/task.hh>
+
 namespace cu0 {
 
 /*!
@@ -202,9 +217,24 @@ public:
   enum struct DetachError {
     PTHREAD_INVAL = EINVAL, //! strand is not detachable
   };
+#endif
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+  //! errors related to retrieval of a cpu affinity
+  enum struct GetAffinityError {
+    PTHREAD_INVAL = EINVAL, //! cpu set is smaller than the one of the kernel
+  };
+#endif
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+  //! errors related to modification of a cpu affinity
+  enum struct SetAffinityError {
+    PTHREAD_INVAL = EINVAL, //! no online cpu was specified
+  };
 #endif
   /*
    * @brief creates a strand instance
+   * @note a task of a small callable is stored inside the strand =>
+   *     no allocation is made for it, move-only callables are supported
+   *     @see Task
    * @param task is the task to be executed after launch @see Strand::run()
    * @return
    *     if no error was reported => strand instance
@@ -216,7 +246,7 @@ public:
 #else
       std::variant<Strand>
 #endif
-      create(std::function<void()> task);
+      create(Task<> task);
 #if __has_include(<pthread.h>)
   /*!
    * @brief gets a priority of this strand
@@ -240,7 +270,7 @@ public:
    */
   template <>
   [[nodiscard]]
-  constexpr std::variant<
+  std::variant<
       PriorityType,
       GetPriorityError
   > priority<Stage::NOT_LAUNCHED>() const;
@@ -252,7 +282,7 @@ public:
    */
   template <>
   [[nodiscard]]
-  constexpr std::variant<
+  std::variant<
       PriorityType,
       GetPriorityError
   > priority<Stage::LAUNCHED>() const;
@@ -280,7 +310,7 @@ public:
    *     else => error code
    */
   template <>
-  constexpr std::variant<std::monostate, SetPriorityError> priority<
+  std::variant<std::monostate, SetPriorityError> priority<
       Stage::NOT_LAUNCHED
   >(const PriorityType& priority);
   /*!
@@ -291,7 +321,7 @@ public:
    *     else => error code
    */
   template <>
-  constexpr std::variant<std::monostate, SetPriorityError> priority<
+  std::variant<std::monostate, SetPriorityError> priority<
       Stage::LAUNCHED
   >(const PriorityType& priority);
 #endif
@@ -320,7 +350,7 @@ public:
    */
   template <>
   [[nodiscard]]
-  constexpr std::variant<
+  std::variant<
       Scheduling,
       GetPolicyError,
       GetPriorityError
@@ -334,7 +364,7 @@ public:
    */
   template <>
   [[nodiscard]]
-  constexpr std::variant<
+  std::variant<
       Scheduling,
       GetPolicyError,
       GetPriorityError
@@ -365,7 +395,7 @@ public:
    *     else => error code
    */
   template <>
-  constexpr std::variant<
+  std::variant<
       std::monostate,
       SetPolicyError,
       SetPriorityError
@@ -380,7 +410,7 @@ public:
    *     else => error code
    */
   template <>
-  constexpr std::variant<
+  std::variant<
       std::monostate,
       SetPolicyError,
       SetPriorityError
@@ -411,7 +441,7 @@ public:
    */
   template <>
   [[nodiscard]]
-  constexpr std::variant<
+  std::variant<
       bool,
       GetDetachedError
   > detached<Stage::NOT_LAUNCHED>() const;
@@ -441,7 +471,7 @@ public:
    *     else => error code
    */
   template <>
-  constexpr std::variant<
+  std::variant<
       std::monostate,
       SetDetachedError
   > detached<Stage::NOT_LAUNCHED>(const bool detached);
@@ -470,7 +500,7 @@ public:
    */
   template <>
   [[nodiscard]]
-  constexpr std::variant<
+  std::variant<
       std::size_t,
       GetStackSizeError
   > stack_size<Stage::NOT_LAUNCHED>() const;
@@ -531,6 +561,88 @@ public:
   std::variant<std::monostate> deallocate_stack<Stage::TERMINATED>();
 #endif
 #endif
+#endif
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+  /*!
+   * @brief gets cpus on which this strand is allowed to run
+   * @note deleted | actual implementations are provided through specializations
+   * @return
+   *     if no error was reported => cpu set
+   *     else => error code
+   */
+  template <Stage stage>
+  [[nodiscard]]
+  std::variant<
+      cpu_set_t,
+      GetAffinityError
+  > affinity() const = delete;
+#if !CU0_DONT_COMPILE_SPECIALIZATION_DECLARATIONS_IN_STRUCT
+  /*!
+   * @brief gets cpus on which this strand will be allowed to run after launch
+   * @return
+   *     if no error was reported => cpu set
+   *     else => error code
+   */
+  template <>
+  [[nodiscard]]
+  std::variant<
+      cpu_set_t,
+      GetAffinityError
+  > affinity<Stage::NOT_LAUNCHED>() const;
+  /*!
+   * @brief gets cpus on which this strand is allowed to run
+   * @return
+   *     if no error was reported => cpu set
+   *     else => error code
+   */
+  template <>
+  [[nodiscard]]
+  std::variant<
+      cpu_set_t,
+      GetAffinityError
+  > affinity<Stage::LAUNCHED>() const;
+#endif
+#endif
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+  /*!
+   * @brief sets cpus on which this strand is allowed to run
+   * @note deleted | actual implementations are provided through specializations
+   * @param affinity is the cpu set to be set @see CpuTopology
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  template <Stage stage>
+  std::variant<
+      std::monostate,
+      SetAffinityError
+  > affinity(const cpu_set_t& affinity) = delete;
+#if !CU0_DONT_COMPILE_SPECIALIZATION_DECLARATIONS_IN_STRUCT
+  /*!
+   * @brief sets cpus on which this strand will be allowed to run after launch
+   * @param affinity is the cpu set to be set
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  template <>
+  std::variant<
+      std::monostate,
+      SetAffinityError
+  > affinity<Stage::NOT_LAUNCHED>(const cpu_set_t& affinity);
+  /*!
+   * @brief sets cpus on which this strand is allowed to continue to run
+   * @param affinity is the cpu set to be set
+   * @return
+   *     if no error was reported => std::monostate
+   *     else => error code
+   */
+  template <>
+  std::variant<
+      std::monostate,
+      SetAffinityError
+  > affinity<Stage::LAUNCHED>(const cpu_set_t& affinity);
+#endif
 #endif
   /*!
    * @brief runs a task specified by this->task_ in a new thread,
@@ -552,7 +664,7 @@ public:
    *     else => error code
    */
 #if __has_include(<pthread.h>)
-  constexpr std::variant<std::monostate, JoinError>
+  std::variant<std::monostate, JoinError>
 #else
   std::variant<std::monostate>
 #endif
@@ -564,7 +676,7 @@ public:
    *     else => error code
    */
 #if __has_include(<pthread.h>)
-  constexpr std::variant<std::monostate, DetachError>
+  std::variant<std::monostate, DetachError>
 #else
   std::variant<std::monostate>
 #endif
@@ -581,7 +693,7 @@ protected:
       Strand() = default;
 #if __has_include(<pthread.h>)
   /*!
-   * @brief calls reinterpret_cast<Strand const *>(args)->task_ task
+   * @brief calls reinterpret_cast<Strand*>(args)->task_ task
    * @note used as a helper to launch a strand
    * @param args is the pointer to the instance of this type
    * @return nullptr
@@ -589,7 +701,7 @@ protected:
   static void* task(void* args);
 #endif
   //! task to be executed after launch
-  std::function<void()> task_{};
+  Task<> task_{};
 #if __has_include(<pthread.h>)
   //! custom stack which is optinally allocated @see stackSize
   void* stack_{};
@@ -619,7 +731,7 @@ std::variant<Strand, typename Strand::ResourceError, typename Strand::InitError>
 std::variant<Strand>
 #endif
 Strand::create(
-    std::function<void()> task
+    Task<> task
 ) {
   auto ret = Strand{};
   ret.task_ = std::move(task);
@@ -639,7 +751,7 @@ Strand::create(
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     typename Strand::PriorityType,
     typename Strand::GetPriorityError
 > Strand::priority<Strand::Stage::NOT_LAUNCHED>() const {
@@ -652,7 +764,7 @@ constexpr std::variant<
 }
 
 template <>
-constexpr std::variant<
+inline std::variant<
     typename Strand::PriorityType,
     typename Strand::GetPriorityError
 > Strand::priority<Strand::Stage::LAUNCHED>() const {
@@ -669,7 +781,7 @@ constexpr std::variant<
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::SetPriorityError
 > Strand::priority<Strand::Stage::NOT_LAUNCHED>(const PriorityType& priority) {
@@ -685,7 +797,7 @@ constexpr std::variant<
 }
 
 template <>
-constexpr std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::SetPriorityError
 > Strand::priority<Strand::Stage::LAUNCHED>(const PriorityType& priority) {
@@ -699,7 +811,7 @@ constexpr std::variant<
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     typename Strand::Scheduling,
     typename Strand::GetPolicyError,
     typename Strand::GetPriorityError
@@ -723,7 +835,7 @@ constexpr std::variant<
 }
 
 template <>
-constexpr std::variant<
+inline std::variant<
     typename Strand::Scheduling,
     typename Strand::GetPolicyError,
     typename Strand::GetPriorityError
@@ -744,7 +856,7 @@ constexpr std::variant<
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::SetPolicyError,
     typename Strand::SetPriorityError
@@ -771,7 +883,7 @@ constexpr std::variant<
 }
 
 template <>
-constexpr std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::SetPolicyError,
     typename Strand::SetPriorityError
@@ -792,7 +904,7 @@ constexpr std::variant<
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     bool,
     typename Strand::GetDetachedError
 > Strand::detached<Strand::Stage::NOT_LAUNCHED>() const {
@@ -810,7 +922,7 @@ constexpr std::variant<
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::SetDetachedError
 > Strand::detached<Strand::Stage::NOT_LAUNCHED>(
@@ -829,7 +941,7 @@ constexpr std::variant<
 
 #if __has_include(<pthread.h>)
 template <>
-constexpr std::variant<
+inline std::variant<
     std::size_t,
     typename Strand::GetStackSizeError
 > Strand::stack_size<Strand::Stage::NOT_LAUNCHED>() const {
@@ -850,7 +962,7 @@ constexpr std::variant<
 #if __has_include(<pthread.h>)
 #if __has_include(<stdlib.h>) && __has_include(<unistd.h>)
 template <>
-std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::SetStackSizeError,
     typename Strand::ResourceError
@@ -881,7 +993,7 @@ std::variant<
 #if __has_include(<pthread.h>)
 #if __has_include(<stdlib.h>) && __has_include(<unistd.h>)
 template <>
-std::variant<
+inline std::variant<
     std::monostate
 > Strand::deallocate_stack<Strand::Stage::TERMINATED>() {
   ::free(this->stack_);
@@ -890,6 +1002,70 @@ std::variant<
 #endif
 #endif
 
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+template <>
+inline std::variant<
+    cpu_set_t,
+    typename Strand::GetAffinityError
+> Strand::affinity<Strand::Stage::NOT_LAUNCHED>() const {
+  auto cpu_set = cpu_set_t{};
+  const auto res = ::pthread_attr_getaffinity_np(
+      &this->attr_,
+      sizeof(cpu_set_t),
+      &cpu_set
+  );
+  if (res != 0) {
+    return static_cast<GetAffinityError>(res);
+  }
+  return cpu_set;
+}
+
+template <>
+inline std::variant<
+    cpu_set_t,
+    typename Strand::GetAffinityError
+> Strand::affinity<Strand::Stage::LAUNCHED>() const {
+  auto cpu_set = cpu_set_t{};
+  const auto res =
+      ::pthread_getaffinity_np(this->thread_, sizeof(cpu_set_t), &cpu_set);
+  if (res != 0) {
+    return static_cast<GetAffinityError>(res);
+  }
+  return cpu_set;
+}
+#endif
+
+#if __has_include(<pthread.h>) && __has_include(<sched.h>)
+template <>
+inline std::variant<
+    std::monostate,
+    typename Strand::SetAffinityError
+> Strand::affinity<Strand::Stage::NOT_LAUNCHED>(const cpu_set_t& affinity) {
+  const auto res = ::pthread_attr_setaffinity_np(
+      &this->attr_,
+      sizeof(cpu_set_t),
+      &affinity
+  );
+  if (res != 0) {
+    return static_cast<SetAffinityError>(res);
+  }
+  return std::monostate{};
+}
+
+template <>
+inline std::variant<
+    std::monostate,
+    typename Strand::SetAffinityError
+> Strand::affinity<Strand::Stage::LAUNCHED>(const cpu_set_t& affinity) {
+  const auto res =
+      ::pthread_setaffinity_np(this->thread_, sizeof(cpu_set_t), &affinity);
+  if (res != 0) {
+    return static_cast<SetAffinityError>(res);
+  }
+  return std::monostate{};
+}
+#endif
+
 inline
 #if __has_include(<pthread.h>)
 std::variant<
@@ -916,13 +1092,13 @@ Strand::run() {
     return static_cast<ResourceError>(attr_destroy_result);
   }
 #else
-  this->thread_ = std::thread(this->task_);
+  this->thread_ = std::thread([this]() { this->task_(); });
 #endif
   return std::monostate{};
 }
 
 #if __has_include(<pthread.h>)
-constexpr std::variant<std::monostate, typename Strand::JoinError>
+inline std::variant<std::monostate, typename Strand::JoinError>
 #else
 std::variant<std::monostate>
 #endif
@@ -940,7 +1116,7 @@ Strand::join() {
 }
 
 #if __has_include(<pthread.h>)
-constexpr std::variant<
+inline std::variant<
     std::monostate,
     typename Strand::DetachError
 >
@@ -954,14 +1130,14 @@ Strand::detach() {
     return static_cast<DetachError>(detach_result);
   }
 #else
-  thread.detach();
+  this->thread_.detach();
 #endif
   return std::monostate{};
 }
 
 #if __has_include(<pthread.h>)
 inline void* Strand::task(void* args) {
-  reinterpret_cast<Strand const *>(args)->task_();
+  reinterpret_cast<Strand*>(args)->task_();
   return nullptr;
 }
 #endif
@@ -0,0 +1,597 @@
+#ifndef CU0_STRAND_POOL_HH__
+#define CU0_STRAND_POOL_HH__
+
+#if !__has_include(<pthread.h>)
+#warning <pthread.h> is not found => \
+    cu0::StrandPool will not be supported
+#endif
+#if !__has_include(<sched.h>)
+#warning <sched.h> is not found => \
+    cu0::StrandPool will not be supported
+#endif
+#if !__has_include(<linux/futex.h>)
+#warning <linux/futex.h> is not found => \
+    cu0::StrandPool will not be supported
+#endif
+#if !__has_include(<sys/syscall.h>)
+#warning <sys/syscall.h> is not found => \
+    cu0::StrandPool will not be supported
+#endif
+#if !__has_include(<stdlib.h>) || !__has_include(<unistd.h>)
+#warning <stdlib.h> or <unistd.h> is not found => \
+    cu0::StrandPool will not be supported
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if __has_include(<sched.h>)
+#include <sched.h>
+#endif
+#if __has_include(<linux/futex.h>)
+#include <linux/futex.h>
+#endif
+#if __has_include(<sys/syscall.h>)
+#include <sys/syscall.h>
+#endif
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <cu0/proc/strand.hh>
+#include <cu0/proc/task.hh>
+
+namespace cu0 {
+
+#if \
+    __has_include(<pthread.h>) && \
+    __has_include(<sched.h>) && \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<stdlib.h>) && \
+    __has_include(<unistd.h>)
+/*!
+ * @brief The StrandPool struct provides a way to execute many tasks by
+ *     a fixed number of strands
+ * @note each strand has its own deque of tasks @see Chase-Lev deque
+ *     a task submitted by a task is pushed to the deque of its strand,
+ *     other tasks are pushed to a shared queue,
+ *     a strand without tasks steals tasks from the deques of other strands
+ * @note a strand which finds no task waits on a futex until a task is
+ *     submitted
+ */
+struct StrandPool {
+public:
+  //! parameters of the strands of a pool
+  struct Options {
+    //! number of strands
+    //! @note if 0 => the number of online processors
+    std::size_t size = 0;
+    //! scheduling parameters of each strand @see Strand::scheduling()
+    std::optional<Strand::Scheduling> scheduling{};
+    //! stack size of each strand in bytes @see Strand::allocate_stack()
+    std::optional<std::size_t> stack_size{};
+    //! cpu sets of the strands @see Strand::affinity(const cpu_set_t&)
+    //! @note the strand i is pinned to affinities[i % affinities.size()],
+    //!     e.g. CpuTopology::spread(size) pins each strand to its own core
+    //! @note if empty => the strands are not pinned
+    std::vector<cpu_set_t> affinities{};
+  };
+  /*!
+   * @brief creates a pool and launches its strands
+   * @note if an error is reported => the strands which have already been
+   *     launched are joined
+   * @param options is the parameters of the strands
+   * @return
+   *     if no error was reported => pool instance
+   *     else => error code
+   */
+  [[nodiscard]]
+  static std::variant<
+      StrandPool,
+      Strand::ResourceError,
+      Strand::InitError,
+      Strand::SetPolicyError,
+      Strand::SetPriorityError,
+      Strand::SetStackSizeError,
+      Strand::SetAffinityError,
+      Strand::RunError
+  > create(const Options& options);
+  /*!
+   * @brief moves pool resources to this pool
+   * @param other is the pool for which resources need to be moved
+   */
+  StrandPool(StrandPool&& other) = default;
+  /*!
+   * @brief stops this pool and moves pool resources to this pool
+   * @param other is the pool for which resources need to be moved
+   * @return this pool as a mutable reference
+   */
+  StrandPool& operator =(StrandPool&& other);
+  /*!
+   * @brief executes the submitted tasks and joins the strands
+   */
+  ~StrandPool();
+  /*!
+   * @brief submits a task to be executed by one of the strands
+   * @note a task submitted by a task of this pool is executed by the same
+   *     strand unless it is stolen
+   * @param task is the task to be executed
+   */
+  void submit(Task<> task);
+  /*!
+   * @brief accesses the number of strands
+   * @return number of strands
+   */
+  [[nodiscard]]
+  std::size_t size() const;
+protected:
+  //! deque of tasks owned by one strand @see Chase-Lev deque
+  struct Deque {
+    //! circular array of tasks
+    struct Array {
+      //! number of slots, a power of 2
+      std::size_t capacity;
+      //! slots of tasks
+      std::unique_ptr<std::atomic<Task<>*>[]> slots;
+    };
+    /*!
+     * @brief constructs an empty deque
+     */
+    Deque();
+    /*!
+     * @brief pushes a task to the bottom
+     * @note called by the owner only
+     * @param task is the task to be pushed
+     */
+    void push(Task<>* task);
+    /*!
+     * @brief takes a task from the bottom
+     * @note called by the owner only
+     * @return
+     *     if the deque is not empty => task
+     *     else => NULL
+     */
+    [[nodiscard]]
+    Task<>* take();
+    /*!
+     * @brief steals a task from the top
+     * @return
+     *     if a task is stolen => task
+     *     else => NULL
+     */
+    [[nodiscard]]
+    Task<>* steal();
+    //! index of the top task, modified by thieves and the owner
+    alignas(64) std::atomic<std::int64_t> top{0};
+    //! index after the bottom task, modified by the owner
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    //! current array
+    std::atomic<Array*> array{};
+    //! current and previous arrays
+    //! @note previous arrays are kept => a thief may still read them
+    std::vector<std::unique_ptr<Array>> arrays{};
+  };
+  //! state shared by a pool and its strands
+  struct State {
+    //! deque of each strand
+    std::vector<std::unique_ptr<Deque>> deques{};
+    //! guards injected
+    std::mutex mutex{};
+    //! tasks submitted not by the strands
+    std::deque<Task<>*> injected{};
+    //! number of tasks in injected
+    std::atomic<std::size_t> injected_size{0};
+    //! futex word which is modified when a task is submitted
+    alignas(64) std::atomic<std::uint32_t> epoch{0};
+    //! number of strands which wait on epoch
+    std::atomic<std::uint32_t> sleeping{0};
+    //! true if the strands need to exit when no task is found
+    std::atomic<bool> stopping{false};
+    //! strands in the order of deques
+    //! @note reserved => strands are not moved after launch
+    std::vector<Strand> strands{};
+    //! number of launched strands
+    std::size_t launched = 0;
+  };
+  //! strand of a pool executing the current thread
+  struct Context {
+    //! state of the pool
+    State* state;
+    //! index of the strand
+    std::size_t index;
+  };
+  //! number of searches for a task before waiting on a futex on
+  //!     multiprocessor systems
+  static constexpr auto SPIN_COUNT = 64;
+  /*!
+   * @brief constructs a pool without strands
+   */
+  StrandPool() = default;
+  /*!
+   * @brief accesses the strand executing the current thread
+   * @return context as a mutable reference
+   *     if the current thread is not a strand of a pool => state is NULL
+   */
+  [[nodiscard]]
+  static Context& current();
+  /*!
+   * @brief executes tasks until the pool is stopped
+   * @param state is the state of the pool
+   * @param index is the index of the strand
+   */
+  static void work(State& state, const std::size_t& index);
+  /*!
+   * @brief finds a task in the own deque, then in the shared queue,
+   *     then in the deques of other strands
+   * @param state is the state of the pool
+   * @param index is the index of the strand
+   * @return
+   *     if a task is found => task
+   *     else => NULL
+   */
+  [[nodiscard]]
+  static Task<>* find(State& state, const std::size_t& index);
+  /*!
+   * @brief wakes one waiting strand if any after a task is submitted
+   * @param state is the state of the pool
+   */
+  static void notify(State& state);
+  /*!
+   * @brief executes the submitted tasks and joins the launched strands
+   */
+  void stop();
+  //! state shared with the strands
+  std::unique_ptr<State> state_{};
+private:
+};
+#endif
+
+} /// namespace cu0
+
+namespace cu0 {
+
+#if \
+    __has_include(<pthread.h>) && \
+    __has_include(<sched.h>) && \
+    __has_include(<linux/futex.h>) && \
+    __has_include(<sys/syscall.h>) && \
+    __has_include(<stdlib.h>) && \
+    __has_include(<unistd.h>)
+inline std::variant<
+    StrandPool,
+    typename Strand::ResourceError,
+    typename Strand::InitError,
+    typename Strand::SetPolicyError,
+    typename Strand::SetPriorityError,
+    typename Strand::SetStackSizeError,
+    typename Strand::SetAffinityError,
+    typename Strand::RunError
+> StrandPool::create(const Options& options) {
+  const auto size = options.size != 0 ?
+      options.size :
+      static_cast<std::size_t>(std::max(::sysconf(_SC_NPROCESSORS_ONLN), 1l));
+  auto ret = StrandPool{};
+  ret.state_ = std::make_unique<State>();
+  auto& state = *ret.state_;
+  state.deques.reserve(size);
+  for (auto i = 0u; i < size; i++) {
+    state.deques.push_back(std::make_unique<Deque>());
+  }
+  state.strands.reserve(size);
+  //! if an error is returned => ret joins the launched strands
+  for (auto i = 0u; i < size; i++) {
+    auto* shared = &state;
+    auto strand_create_variant = Strand::create([shared, i]() {
+      StrandPool::work(*shared, i);
+    });
+    if (std::holds_alternative<Strand::ResourceError>(strand_create_variant)) {
+      return std::get<Strand::ResourceError>(strand_create_variant);
+    }
+    if (std::holds_alternative<Strand::InitError>(strand_create_variant)) {
+      return std::get<Strand::InitError>(strand_create_variant);
+    }
+    state.strands.push_back(
+        std::move(std::get<Strand>(strand_create_variant))
+    );
+    auto& strand = state.strands.back();
+    if (options.scheduling.has_value()) {
+      const auto scheduling_set_variant =
+          strand.scheduling<Strand::Stage::NOT_LAUNCHED>(
+              options.scheduling.value()
+          );
+      if (std::holds_alternative<Strand::SetPolicyError>(
+          scheduling_set_variant
+      )) {
+        return std::get<Strand::SetPolicyError>(scheduling_set_variant);
+      }
+      if (std::holds_alternative<Strand::SetPriorityError>(
+          scheduling_set_variant
+      )) {
+        return std::get<Strand::SetPriorityError>(scheduling_set_variant);
+      }
+    }
+    if (options.stack_size.has_value()) {
+      const auto allocate_stack_variant =
+          strand.allocate_stack<Strand::Stage::NOT_LAUNCHED>(
+              options.stack_size.value()
+          );
+      if (std::holds_alternative<Strand::SetStackSizeError>(
+          allocate_stack_variant
+      )) {
+        return std::get<Strand::SetStackSizeError>(allocate_stack_variant);
+      }
+      if (std::holds_alternative<Strand::ResourceError>(
+          allocate_stack_variant
+      )) {
+        return std::get<Strand::ResourceError>(allocate_stack_variant);
+      }
+    }
+    if (!options.affinities.empty()) {
+      const auto affinity_set_variant =
+          strand.affinity<Strand::Stage::NOT_LAUNCHED>(
+              options.affinities[i % options.affinities.size()]
+          );
+      if (std::holds_alternative<Strand::SetAffinityError>(
+          affinity_set_variant
+      )) {
+        return std::get<Strand::SetAffinityError>(affinity_set_variant);
+      }
+    }
+    const auto run_variant = strand.run();
+    if (std::holds_alternative<Strand::RunError>(run_variant)) {
+      return std::get<Strand::RunError>(run_variant);
+    }
+    state.launched++;
+    if (std::holds_alternative<Strand::ResourceError>(run_variant)) {
+      return std::get<Strand::ResourceError>(run_variant);
+    }
+  }
+  return ret;
+}
+
+inline StrandPool& StrandPool::operator =(StrandPool&& other) {
+  if (this != &other) {
+    this->stop();
+    this->state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+inline StrandPool::~StrandPool() {
+  this->stop();
+}
+
+inline void StrandPool::submit(Task<> task) {
+  auto* submitted = new Task<>(std::move(task));
+  auto& state = *this->state_;
+  const auto& context = StrandPool::current();
+  if (context.state == &state) {
+    state.deques[context.index]->push(submitted);
+  } else {
+    const auto lock = std::lock_guard{state.mutex};
+    state.injected.push_back(submitted);
+    state.injected_size.fetch_add(1);
+  }
+  StrandPool::notify(state);
+}
+
+inline std::size_t StrandPool::size() const {
+  return this->state_->deques.size();
+}
+
+inline StrandPool::Deque::Deque() {
+  constexpr auto CAPACITY = std::size_t{256};
+  this->arrays.push_back(std::make_unique<Array>(Array{
+    .capacity = CAPACITY,
+    .slots = std::make_unique<std::atomic<Task<>*>[]>(CAPACITY),
+  }));
+  this->array.store(this->arrays.back().get(), std::memory_order_relaxed);
+}
+
+inline void StrandPool::Deque::push(Task<>* task) {
+  const auto b = this->bottom.load(std::memory_order_relaxed);
+  const auto t = this->top.load(std::memory_order_acquire);
+  auto* a = this->array.load(std::memory_order_relaxed);
+  if (b - t > static_cast<std::int64_t>(a->capacity) - 1) {
+    //! the array is full => the tasks are copied to a twice larger array
+    auto grown = std::make_unique<Array>(Array{
+      .capacity = a->capacity * 2,
+      .slots = std::make_unique<std::atomic<Task<>*>[]>(a->capacity * 2),
+    });
+    for (auto i = t; i < b; i++) {
+      grown->slots[i & (grown->capacity - 1)].store(
+          a->slots[i & (a->capacity - 1)].load(std::memory_order_relaxed),
+          std::memory_order_relaxed
+      );
+    }
+    a = grown.get();
+    this->arrays.push_back(std::move(grown));
+    this->array.store(a, std::memory_order_release);
+  }
+  a->slots[b & (a->capacity - 1)].store(task, std::memory_order_relaxed);
+  //! the task is published to the thieves loading bottom
+  this->bottom.store(b + 1, std::memory_order_release);
+}
+
+inline Task<>* StrandPool::Deque::take() {
+  const auto b = this->bottom.load(std::memory_order_relaxed) - 1;
+  auto* a = this->array.load(std::memory_order_relaxed);
+  this->bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto t = this->top.load(std::memory_order_relaxed);
+  if (t > b) {
+    //! the deque is empty
+    this->bottom.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto* ret = a->slots[b & (a->capacity - 1)].load(std::memory_order_relaxed);
+  if (t == b) {
+    //! the last task => the owner races with thieves
+    if (!this->top.compare_exchange_strong(
+        t,
+        t + 1,
+        std::memory_order_seq_cst,
+        std::memory_order_relaxed
+    )) {
+      ret = nullptr;
+    }
+    this->bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+inline Task<>* StrandPool::Deque::steal() {
+  auto t = this->top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto b = this->bottom.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  auto* a = this->array.load(std::memory_order_acquire);
+  auto* ret = a->slots[t & (a->capacity - 1)].load(std::memory_order_relaxed);
+  if (!this->top.compare_exchange_strong(
+      t,
+      t + 1,
+      std::memory_order_seq_cst,
+      std::memory_order_relaxed
+  )) {
+    //! another thief or the owner has taken the task
+    return nullptr;
+  }
+  return ret;
+}
+
+inline typename StrandPool::Context& StrandPool::current() {
+  static thread_local auto context = Context{
+    .state = nullptr,
+    .index = 0,
+  };
+  return context;
+}
+
+inline void StrandPool::work(State& state, const std::size_t& index) {
+  StrandPool::current() = Context{
+    .state = &state,
+    .index = index,
+  };
+  //! spinning only delays the other strands if there is one processor
+  static const auto spin_count =
+      ::sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SPIN_COUNT : 0;
+  while (true) {
+    auto* task = StrandPool::find(state, index);
+    for (auto i = 0; task == nullptr && i < spin_count; i++) {
+      task = StrandPool::find(state, index);
+    }
+    if (task == nullptr) {
+      const auto epoch = state.epoch.load();
+      //! announce the wait before the last search =>
+      //!     a submission either sees the announcement or
+      //!     its task is found by the last search
+      state.sleeping.fetch_add(1);
+      task = StrandPool::find(state, index);
+      if (task == nullptr) {
+        if (state.stopping.load()) {
+          state.sleeping.fetch_sub(1);
+          break;
+        }
+        //! do not handle errors if any, tasks are searched again
+        ::syscall(
+            SYS_futex,
+            &state.epoch,
+            FUTEX_WAIT_PRIVATE,
+            epoch,
+            NULL,
+            NULL,
+            0
+        );
+      }
+      state.sleeping.fetch_sub(1);
+      if (task == nullptr) {
+        continue;
+      }
+    }
+    (*task)();
+    delete task;
+  }
+  StrandPool::current() = Context{
+    .state = nullptr,
+    .index = 0,
+  };
+}
+
+inline Task<>* StrandPool::find(State& state, const std::size_t& index) {
+  if (auto* task = state.deques[index]->take(); task != nullptr) {
+    return task;
+  }
+  if (state.injected_size.load() > 0) {
+    const auto lock = std::lock_guard{state.mutex};
+    if (!state.injected.empty()) {
+      auto* task = state.injected.front();
+      state.injected.pop_front();
+      state.injected_size.fetch_sub(1);
+      return task;
+    }
+  }
+  const auto size = state.deques.size();
+  for (auto i = 1u; i < size; i++) {
+    auto* task = state.deques[(index + i) % size]->steal();
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+inline void StrandPool::notify(State& state) {
+  state.epoch.fetch_add(1);
+  if (state.sleeping.load() > 0) {
+    //! do not handle errors if any
+    ::syscall(SYS_futex, &state.epoch, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+  }
+}
+
+inline void StrandPool::stop() {
+  if (this->state_ == nullptr) {
+    return;
+  }
+  auto& state = *this->state_;
+  state.stopping.store(true);
+  state.epoch.fetch_add(1);
+  //! do not handle errors if any
+  ::syscall(
+      SYS_futex,
+      &state.epoch,
+      FUTEX_WAKE_PRIVATE,
+      INT_MAX,
+      NULL,
+      NULL,
+      0
+  );
+  for (auto i = 0u; i < state.launched; i++) {
+    [[maybe_unused]] const auto join_variant = state.strands[i].join();
+  }
+  for (auto& strand : state.strands) {
+    //! no stack is freed if it was not allocated
+    strand.deallocate_stack<Strand::Stage::TERMINATED>();
+  }
+  //! the tasks are left if no strand was launched
+  for (auto* task : state.injected) {
+    delete task;
+  }
+  this->state_.reset();
+}
+#endif
+
+} /// namespace cu0
+
+#endif /// CU0_STRAND_POOL_HH__
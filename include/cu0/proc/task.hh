@@ -0,0 +1,229 @@
+#ifndef CU0_TASK_HH__
+#define CU0_TASK_HH__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cu0 {
+
+/*!
+ * @brief The Task struct represents a move-only callable without arguments
+ *     and without a result
+ * @note a callable which fits into the buffer is stored inside the task =>
+ *     creating and moving such a task does not allocate, other callables are
+ *     allocated on the heap
+ * @note unlike std::function, callables with move-only captures
+ *     (e.g. std::unique_ptr or std::promise) can be stored
+ * @tparam BUFFER_SIZE is the size of the buffer for a callable in bytes
+ */
+template <std::size_t BUFFER_SIZE = 64>
+struct Task {
+  static_assert(
+      BUFFER_SIZE >= sizeof(void*),
+      "BUFFER_SIZE needs to be enough for a pointer"
+  );
+public:
+  /*!
+   * @brief checks if a callable is stored inside a task
+   * @tparam Callable is the type of the callable
+   * @return
+   *     if the callable fits into the buffer and is nothrow movable => true
+   *     else => false
+   */
+  template <class Callable>
+  [[nodiscard]]
+  static constexpr bool stored_inline();
+  /*!
+   * @brief constructs an empty task
+   */
+  Task() = default;
+  /*!
+   * @brief constructs a task storing a callable
+   * @param callable is the callable to be called by the task
+   */
+  template <class Callable>
+  requires (
+      !std::is_same_v<std::remove_cvref_t<Callable>, Task> &&
+      std::is_invocable_v<std::decay_t<Callable>&>
+  )
+  Task(Callable&& callable);
+  Task(const Task& other) = delete;
+  Task& operator =(const Task& other) = delete;
+  /*!
+   * @brief moves the callable of a task to this task
+   * @param other is the task for which the callable needs to be moved
+   */
+  Task(Task&& other) noexcept;
+  /*!
+   * @brief moves the callable of a task to this task
+   * @param other is the task for which the callable needs to be moved
+   * @return this task as a mutable reference
+   */
+  Task& operator =(Task&& other) noexcept;
+  /*!
+   * @brief destructs the stored callable
+   */
+  ~Task();
+  /*!
+   * @brief calls the stored callable
+   * @note the behaviour is undefined if the task is empty
+   */
+  void operator ()();
+  /*!
+   * @brief checks if a callable is stored
+   * @return
+   *     if a callable is stored => true
+   *     else => false
+   */
+  [[nodiscard]]
+  explicit operator bool() const;
+protected:
+  //! operations on a stored callable of one type
+  struct Operations {
+    //! calls the callable stored in the buffer
+    void (*call)(void* buffer);
+    //! moves the callable from the buffer to the empty buffer and
+    //!     destructs the moved callable
+    void (*relocate)(void* from, void* to) noexcept;
+    //! destructs the callable stored in the buffer
+    void (*destroy)(void* buffer) noexcept;
+  };
+  /*!
+   * @brief accesses the operations on a stored callable
+   * @tparam Callable is the type of the callable
+   * @return operations shared by all the tasks storing Callable
+   */
+  template <class Callable>
+  [[nodiscard]]
+  static const Operations* operations();
+  /*!
+   * @brief destructs the stored callable if any, the task becomes empty
+   */
+  void reset() noexcept;
+  //! callable if stored inline else pointer to the callable
+  alignas(std::max_align_t) std::byte buffer_[BUFFER_SIZE];
+  //! operations on the stored callable
+  //! @note if NULL => the task is empty
+  const Operations* operations_ = nullptr;
+private:
+};
+
+} /// namespace cu0
+
+namespace cu0 {
+
+template <std::size_t BUFFER_SIZE>
+template <class Callable>
+constexpr bool Task<BUFFER_SIZE>::stored_inline() {
+  return sizeof(Callable) <= BUFFER_SIZE &&
+      alignof(Callable) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<Callable>;
+}
+
+template <std::size_t BUFFER_SIZE>
+template <class Callable>
+requires (
+    !std::is_same_v<std::remove_cvref_t<Callable>, Task<BUFFER_SIZE>> &&
+    std::is_invocable_v<std::decay_t<Callable>&>
+)
+inline Task<BUFFER_SIZE>::Task(Callable&& callable) {
+  using Stored = std::decay_t<Callable>;
+  if constexpr (Task::stored_inline<Stored>()) {
+    ::new (static_cast<void*>(this->buffer_))
+        Stored(std::forward<Callable>(callable));
+  } else {
+    ::new (static_cast<void*>(this->buffer_))
+        Stored*(new Stored(std::forward<Callable>(callable)));
+  }
+  this->operations_ = Task::operations<Stored>();
+}
+
+template <std::size_t BUFFER_SIZE>
+inline Task<BUFFER_SIZE>::Task(Task&& other) noexcept
+    : operations_{other.operations_} {
+  if (this->operations_ != nullptr) {
+    this->operations_->relocate(other.buffer_, this->buffer_);
+    other.operations_ = nullptr;
+  }
+}
+
+template <std::size_t BUFFER_SIZE>
+inline Task<BUFFER_SIZE>& Task<BUFFER_SIZE>::operator =(
+    Task&& other
+) noexcept {
+  if (this != &other) {
+    this->reset();
+    if (other.operations_ != nullptr) {
+      other.operations_->relocate(other.buffer_, this->buffer_);
+      this->operations_ = other.operations_;
+      other.operations_ = nullptr;
+    }
+  }
+  return *this;
+}
+
+template <std::size_t BUFFER_SIZE>
+inline Task<BUFFER_SIZE>::~Task() {
+  this->reset();
+}
+
+template <std::size_t BUFFER_SIZE>
+inline void Task<BUFFER_SIZE>::operator ()() {
+  this->operations_->call(this->buffer_);
+}
+
+template <std::size_t BUFFER_SIZE>
+inline Task<BUFFER_SIZE>::operator bool() const {
+  return this->operations_ != nullptr;
+}
+
+template <std::size_t BUFFER_SIZE>
+template <class Callable>
+inline const typename Task<BUFFER_SIZE>::Operations*
+Task<BUFFER_SIZE>::operations() {
+  if constexpr (Task::stored_inline<Callable>()) {
+    static constexpr auto OPERATIONS = Operations{
+      .call = [](void* buffer) {
+        (*std::launder(static_cast<Callable*>(buffer)))();
+      },
+      .relocate = [](void* from, void* to) noexcept {
+        auto* callable = std::launder(static_cast<Callable*>(from));
+        ::new (to) Callable(std::move(*callable));
+        callable->~Callable();
+      },
+      .destroy = [](void* buffer) noexcept {
+        std::launder(static_cast<Callable*>(buffer))->~Callable();
+      },
+    };
+    return &OPERATIONS;
+  } else {
+    //! only the pointer is moved => the callable is not required to be
+    //!     movable after construction
+    static constexpr auto OPERATIONS = Operations{
+      .call = [](void* buffer) {
+        (**std::launder(static_cast<Callable**>(buffer)))();
+      },
+      .relocate = [](void* from, void* to) noexcept {
+        ::new (to) Callable*(*std::launder(static_cast<Callable**>(from)));
+      },
+      .destroy = [](void* buffer) noexcept {
+        delete *std::launder(static_cast<Callable**>(buffer));
+      },
+    };
+    return &OPERATIONS;
+  }
+}
+
+template <std::size_t BUFFER_SIZE>
+inline void Task<BUFFER_SIZE>::reset() noexcept {
+  if (this->operations_ != nullptr) {
+    this->operations_->destroy(this->buffer_);
+    this->operations_ = nullptr;
+  }
+}
+
+} /// namespace cu0
+
+#endif /// CU0_TASK_HH__
@@ -0,0 +1,183 @@
+//! compares cu0::Channel with stdin and stdout pipes of cu0::Process
+//!     throughput: the child sends a number of bytes to the parent
+//!     latency: the parent and the child exchange a byte a number of times
+
+#include <cu0/proc/channel.hh>
+#include <cu0/proc/process.hh>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if \
+    !__has_include(<linux/futex.h>) || \
+    !__has_include(<sys/mman.h>) || \
+    !__has_include(<sys/syscall.h>) || \
+    !__has_include(<sys/wait.h>)
+#warning <linux/futex.h> or <sys/mman.h> or <sys/syscall.h> or <sys/wait.h> \
+is not found => measurement_cu0_channel will be hollow
+int main() {}
+#else
+
+constexpr auto BYTES = std::size_t{1} << 30; //! [B]
+constexpr auto CHUNK = std::size_t{1} << 16; //! [B]
+constexpr auto ROUND_TRIPS = 1 << 14;
+
+int child(const std::string& mode, const int& fd) {
+  auto buffer = std::vector<char>(CHUNK, 'x');
+  if (mode == "pipe-throughput") {
+    for (auto sent = std::size_t{0}; sent < BYTES;) {
+      const auto bytes = ::write(STDOUT_FILENO, buffer.data(), CHUNK);
+      if (bytes <= 0) {
+        return 1;
+      }
+      sent += bytes;
+    }
+    return 0;
+  }
+  if (mode == "pipe-latency") {
+    for (auto i = 0; i < ROUND_TRIPS; i++) {
+      if (
+          ::read(STDIN_FILENO, buffer.data(), 1) != 1 ||
+          ::write(STDOUT_FILENO, buffer.data(), 1) != 1
+      ) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+  auto attached = cu0::Channel::attach(fd);
+  if (!std::holds_alternative<cu0::Channel>(attached)) {
+    return 1;
+  }
+  const auto& channel = std::get<cu0::Channel>(attached);
+  if (mode == "channel-throughput") {
+    for (auto sent = std::size_t{0}; sent < BYTES; sent += CHUNK) {
+      if (channel.write(buffer.data(), CHUNK) != CHUNK) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+  if (mode == "channel-latency") {
+    for (auto i = 0; i < ROUND_TRIPS; i++) {
+      if (
+          channel.read(buffer.data(), 1) != 1 ||
+          channel.write(buffer.data(), 1) != 1
+      ) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+  return 1;
+}
+
+void report(
+    const std::string& name,
+    const std::chrono::nanoseconds& elapsed
+) {
+  const auto seconds = std::chrono::duration<double>(elapsed).count();
+  if (name.ends_with("throughput")) {
+    std::cout << name << ": " << BYTES / seconds / (1 << 30) << "GiB/s" << '\n';
+  } else {
+    std::cout << name << ": " <<
+        static_cast<double>(elapsed.count()) / ROUND_TRIPS << "ns" << '\n';
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    return child(argv[1], argc > 2 ? std::stoi(argv[2]) : -1);
+  }
+  auto buffer = std::vector<char>(CHUNK, 'x');
+  {
+    auto variant = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "pipe-throughput", },
+    });
+    auto& process = std::get<cu0::Process>(variant);
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto received = std::size_t{0}; received < BYTES;) {
+      const auto bytes =
+          ::read(process.stdout_pipe().value(), buffer.data(), CHUNK);
+      if (bytes <= 0) {
+        break;
+      }
+      received += bytes;
+    }
+    report("pipe-throughput", std::chrono::high_resolution_clock::now() - start);
+    process.wait();
+  }
+  {
+    auto created = cu0::Channel::create(std::size_t{1} << 20);
+    const auto& channel = std::get<cu0::Channel>(created);
+    auto variant = cu0::Process::create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "channel-throughput", std::to_string(channel.fd()), },
+        },
+        channel
+    );
+    auto& process = std::get<cu0::Process>(variant);
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto received = std::size_t{0}; received < BYTES;) {
+      const auto bytes = channel.read(buffer.data(), CHUNK);
+      if (bytes == 0) {
+        break;
+      }
+      received += bytes;
+    }
+    report(
+        "channel-throughput",
+        std::chrono::high_resolution_clock::now() - start
+    );
+    process.wait();
+  }
+  {
+    auto variant = cu0::Process::create(cu0::Executable{
+      .binary = argv[0],
+      .arguments = { "pipe-latency", },
+    });
+    auto& process = std::get<cu0::Process>(variant);
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto i = 0; i < ROUND_TRIPS; i++) {
+      if (
+          ::write(process.stdin_pipe().value(), buffer.data(), 1) != 1 ||
+          ::read(process.stdout_pipe().value(), buffer.data(), 1) != 1
+      ) {
+        break;
+      }
+    }
+    report("pipe-latency", std::chrono::high_resolution_clock::now() - start);
+    process.wait();
+  }
+  {
+    auto created = cu0::Channel::create(4096);
+    const auto& channel = std::get<cu0::Channel>(created);
+    auto variant = cu0::Process::create(
+        cu0::Executable{
+          .binary = argv[0],
+          .arguments = { "channel-latency", std::to_string(channel.fd()), },
+        },
+        channel
+    );
+    auto& process = std::get<cu0::Process>(variant);
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto i = 0; i < ROUND_TRIPS; i++) {
+      if (
+          channel.write(buffer.data(), 1) != 1 ||
+          channel.read(buffer.data(), 1) != 1
+      ) {
+        break;
+      }
+    }
+    report(
+        "channel-latency",
+        std::chrono::high_resolution_clock::now() - start
+    );
+    process.wait();
+  }
+}
+
+#endif
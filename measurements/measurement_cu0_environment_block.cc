@@ -0,0 +1,45 @@
+//! measures latency of preparing an environment vector for a process
+//!     format: util::envp_of() formats Executable::environment
+//!     block: a copy of a cu0::EnvironmentBlock formatted once is taken
+
+#include <cu0/env/environment_block.hh>
+#include <cu0/proc/executable.hh>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+constexpr auto SPAWNS = 1000;
+
+template<typename F>
+std::chrono::nanoseconds measure(const F& prepare) {
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (auto i = 0; i < SPAWNS; i++) {
+    prepare();
+  }
+  return (std::chrono::high_resolution_clock::now() - start) / SPAWNS;
+}
+
+int main() {
+  for (const auto& variables : { 10, 100, 1000, }) {
+    auto executable = cu0::Executable{};
+    for (auto i = 0; i < variables; i++) {
+      executable.environment.emplace(
+          "SOME_VARIABLE_" + std::to_string(i),
+          "/some/value/of/a/typical/length/" + std::to_string(i)
+      );
+    }
+    const auto block = cu0::EnvironmentBlock::of(executable.environment);
+    //! the first string is kept for the preparation not to be optimized out
+    auto first = static_cast<const char*>(nullptr);
+    std::cout << "variables: " << variables << '\n';
+    std::cout << "format: " << measure([&] {
+      const auto [formatted, size] = cu0::util::envp_of(executable);
+      first = formatted[0].get();
+    }).count() << "ns" << '\n';
+    std::cout << "block: " << measure([&] {
+      const auto copy = block;
+      first = copy.envp()[0];
+    }).count() << "ns" << '\n';
+    (void)first;
+  }
+}
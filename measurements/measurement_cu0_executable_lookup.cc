@@ -0,0 +1,67 @@
+//! measures latency of finding executables in a large directory
+//!     scan: the entries of the directory are compared with a name
+//!     exists: the path of an executable is checked by ::fstatat()
+//!     executable: the path of an executable is checked by ::fstatat() and
+//!         ::faccessat()
+//!     bulk: the entries of the directory are read once for all the names
+
+#include <cu0/proc/executable.hh>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if !__has_include(<dirent.h>) || !__has_include(<sys/stat.h>)
+#warning <dirent.h> or <sys/stat.h> is not found => \
+measurement_cu0_executable_lookup will be hollow
+int main() {}
+#else
+
+constexpr auto FILES = 5000;
+constexpr auto NAMES = 64;
+
+template<typename F>
+std::chrono::nanoseconds measure(const F& find) {
+  const auto start = std::chrono::high_resolution_clock::now();
+  find();
+  return (std::chrono::high_resolution_clock::now() - start) / NAMES;
+}
+
+int main() {
+  const auto directory =
+      std::filesystem::temp_directory_path() /
+      "measurement_cu0_executable_lookup";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directory(directory);
+  for (auto i = 0; i < FILES; i++) {
+    std::ofstream{directory / ("file" + std::to_string(i))};
+  }
+  //! names are spread over the directory, every second name is not found
+  auto names = std::vector<std::string>{};
+  for (auto i = 0; i < NAMES; i++) {
+    names.push_back(
+        (i % 2 == 0 ? "file" : "missing") + std::to_string(i * FILES / NAMES)
+    );
+  }
+  const auto find_each = [&](const cu0::util::Lookup& lookup) {
+    return measure([&] {
+      for (const auto& name : names) {
+        (void)cu0::util::find_by(name, directory, lookup);
+      }
+    });
+  };
+  std::cout << "files: " << FILES << ", names: " << NAMES << '\n';
+  std::cout << "scan: " <<
+      find_each(cu0::util::Lookup::SCAN).count() << "ns" << '\n';
+  std::cout << "exists: " <<
+      find_each(cu0::util::Lookup::EXISTS).count() << "ns" << '\n';
+  std::cout << "executable: " <<
+      find_each(cu0::util::Lookup::EXECUTABLE).count() << "ns" << '\n';
+  std::cout << "bulk: " << measure([&] {
+    (void)cu0::util::find_by(std::span<const std::string>{names}, directory);
+  }).count() << "ns" << '\n';
+  std::filesystem::remove_all(directory);
+}
+
+#endif
@@ -0,0 +1,74 @@
+//! measures latency of creating and waiting for a process while this process
+//!     has many open file descriptors which are inherited by default
+//!     leaked: all the file descriptors are inherited
+//!     close_others: only stdin, stdout and stderr are inherited
+
+#include <cu0/proc/process.hh>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if \
+    !__has_include(<fcntl.h>) || \
+    !__has_include(<sys/resource.h>) || \
+    !__has_include(<sys/wait.h>)
+#warning <fcntl.h> or <sys/resource.h> or <sys/wait.h> is not found => \
+measurement_cu0_process_descriptors will be hollow
+int main() {}
+#else
+
+constexpr auto DESCRIPTORS = 50000;
+constexpr auto PROCESSES = 256;
+
+std::chrono::nanoseconds measure(
+    const cu0::Executable& executable,
+    const cu0::SpawnOptions& options
+) {
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (auto i = 0; i < PROCESSES; i++) {
+    auto variant = cu0::Process::create_pipeless(executable, options);
+    std::get<cu0::Process>(variant).wait();
+  }
+  return (std::chrono::high_resolution_clock::now() - start) / PROCESSES;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    return 0;
+  }
+  //! the number of file descriptors is limited by RLIMIT_NOFILE
+  auto limit = rlimit{};
+  ::getrlimit(RLIMIT_NOFILE, &limit);
+  limit.rlim_cur = limit.rlim_max;
+  ::setrlimit(RLIMIT_NOFILE, &limit);
+  const auto descriptors = static_cast<int>(
+      std::min<rlim_t>(DESCRIPTORS, limit.rlim_cur - 64)
+  );
+  const auto null = ::open("/dev/null", O_RDONLY);
+  auto opened = std::vector<int>{};
+  for (auto i = 0; i < descriptors; i++) {
+    opened.push_back(::dup(null));
+  }
+  const auto executable = cu0::Executable{
+    .binary = argv[0],
+    .arguments = {"exit"},
+  };
+  std::cout << "open file descriptors: " << descriptors << '\n';
+  std::cout << "leaked: " << measure(executable, {}).count() << "ns" << '\n';
+  std::cout << "close_others: " <<
+      measure(executable, cu0::SpawnOptions{ .close_others = true, }).count() <<
+      "ns" << '\n';
+  for (const auto& fd : opened) {
+    ::close(fd);
+  }
+  ::close(null);
+  std::cout << "open file descriptors: 3" << '\n';
+  std::cout << "leaked: " << measure(executable, {}).count() << "ns" << '\n';
+  std::cout << "close_others: " <<
+      measure(executable, cu0::SpawnOptions{ .close_others = true, }).count() <<
+      "ns" << '\n';
+}
+
+#endif
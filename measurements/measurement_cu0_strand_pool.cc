@@ -0,0 +1,82 @@
+//! measures throughput of executing tasks
+//!     strand: a cu0::Strand is created, run and joined per task
+//!     pool: tasks are submitted to a cu0::StrandPool of 1..N strands
+//! tasks of each size spin for the specified number of iterations
+
+#include <cu0/proc/strand.hh>
+#include <cu0/proc/strand_pool.hh>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <latch>
+
+#include <unistd.h>
+
+constexpr auto TASKS = 100000;
+
+//! spins for the specified number of iterations
+void spin(const int& iterations) {
+  for (auto i = 0; i < iterations; i++) {
+    //! the loop is not optimized out
+    asm volatile("" ::: "memory");
+  }
+}
+
+//! measures the average duration of a task executed by a new strand
+std::chrono::nanoseconds measure_strands(const int& iterations) {
+  constexpr auto STRANDS = 1000;
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (auto i = 0; i < STRANDS; i++) {
+    auto strand_create_variant = cu0::Strand::create([iterations]() {
+      spin(iterations);
+    });
+    auto& strand = std::get<cu0::Strand>(strand_create_variant);
+    strand.run();
+    strand.join();
+  }
+  return (std::chrono::high_resolution_clock::now() - start) / STRANDS;
+}
+
+//! measures the average duration of a task executed by a pool
+std::chrono::nanoseconds measure_pool(
+    const std::size_t& size,
+    const int& iterations
+) {
+  auto create_variant = cu0::StrandPool::create({ .size = size, });
+  assert(std::holds_alternative<cu0::StrandPool>(create_variant));
+  auto& pool = std::get<cu0::StrandPool>(create_variant);
+  auto latch = std::latch{TASKS};
+  const auto start = std::chrono::high_resolution_clock::now();
+  //! tasks are submitted by a few tasks => the strands steal them
+  for (auto i = 0; i < 16; i++) {
+    pool.submit([&pool, &latch, iterations]() {
+      for (auto j = 0; j < TASKS / 16; j++) {
+        pool.submit([&latch, iterations]() {
+          spin(iterations);
+          latch.count_down();
+        });
+      }
+    });
+  }
+  latch.wait();
+  return (std::chrono::high_resolution_clock::now() - start) / TASKS;
+}
+
+int main() {
+  const auto processors =
+      static_cast<std::size_t>(::sysconf(_SC_NPROCESSORS_ONLN));
+  for (const auto& iterations : { 0, 100, 10000, }) {
+    std::cout << "iterations: " << iterations << '\n';
+    std::cout << "strand: " << measure_strands(iterations).count() << "ns"
+        << '\n';
+    //! 1, 2, 4, ... strands and a strand per processor
+    for (auto size = std::size_t{1};; size = std::min(size * 2, processors)) {
+      std::cout << "pool of " << size << ": "
+          << measure_pool(size, iterations).count() << "ns" << '\n';
+      if (size == processors) {
+        break;
+      }
+    }
+  }
+}